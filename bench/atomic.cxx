@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compare pos::AtomicVar operations against kernel atomic
+ * variable, and pos::SeqLock against pos::Mutex for
+ * read-mostly shared data. AtomicVar variant is "native" when
+ * native atomic instructions are used and "schedlock" when
+ * scheduler lock is used instead (OOCFG_ATOMIC_NATIVE is 0). In sharedRead, several reader tasks
+ * copy a snapshot as fast as they can while a higher priority
+ * writer updates it every tick. Readers check that every
+ * snapshot they get is consistent.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.hxx"
+
+namespace {
+
+  const unsigned long ROUNDS = 1000;
+  const unsigned long BATCH = 1000;
+  const unsigned long READS = 200000;
+  const int READERS = 3;
+
+  struct Snapshot
+  {
+    UINT_t serial;
+    INT_t values[16];
+  };
+
+  pos::SeqLock<Snapshot> seqShared;
+  pos::Mutex mutex;
+  Snapshot mutexShared;
+  pos::Sema done;
+  volatile bool readersDone;
+
+  void check(const Snapshot& s)
+  {
+    for (int i = 0; i < 16; ++i) {
+
+      if (s.values[i] != (INT_t)s.serial) {
+
+        printf("sharedRead: inconsistent snapshot\n");
+        exit(1);
+      }
+    }
+  }
+
+  void fill(Snapshot& s, UINT_t serial)
+  {
+    s.serial = serial;
+    for (int i = 0; i < 16; ++i)
+      s.values[i] = serial;
+  }
+
+  void seqReader(void*)
+  {
+    Snapshot s;
+
+    for (unsigned long i = 0; i < READS; ++i) {
+
+      seqShared.read(s);
+      check(s);
+    }
+
+    done.signal();
+  }
+
+  void mutexReader(void*)
+  {
+    Snapshot s;
+
+    for (unsigned long i = 0; i < READS; ++i) {
+
+      mutex.lock();
+      s = mutexShared;
+      mutex.unlock();
+      check(s);
+    }
+
+    done.signal();
+  }
+
+  void seqWriter(void*)
+  {
+    Snapshot s;
+    UINT_t serial = 0;
+
+    while (!readersDone) {
+
+      pos::Task::sleep(1);
+      fill(s, ++serial);
+      seqShared.write(s);
+    }
+
+    done.signal();
+  }
+
+  void mutexWriter(void*)
+  {
+    Snapshot s;
+    UINT_t serial = 0;
+
+    while (!readersDone) {
+
+      pos::Task::sleep(1);
+      fill(s, ++serial);
+      mutex.lock();
+      mutexShared = s;
+      mutex.unlock();
+    }
+
+    done.signal();
+  }
+
+  void sharedRead(const char* variant, POSTASKFUNC_t reader, POSTASKFUNC_t writer)
+  {
+    bench::Nanos start;
+
+    readersDone = false;
+    bench::startTask(writer, NULL, bench::PRIO_HIGH, "writer");
+
+    start = bench::now();
+    for (int i = 0; i < READERS; ++i)
+      bench::startTask(reader, NULL, bench::PRIO_LOW, variant);
+
+    for (int i = 0; i < READERS; ++i)
+      done.get();
+
+    bench::report("sharedRead", variant, READERS * READS,
+                  bench::now() - start, 0, 0);
+    readersDone = true;
+    done.get();
+  }
+
+  template<typename F>
+  void atomicOp(const char* name, const char* variant, F op)
+  {
+    bench::Samples samples(ROUNDS);
+    bench::Nanos t;
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      for (unsigned long b = 0; b < BATCH; ++b)
+        op();
+
+      samples.lap(t, BATCH);
+    }
+
+    bench::report(name, variant, samples);
+  }
+
+  pos::AtomicVar<INT_t> var;
+
+#if POSCFG_FEATURE_ATOMICVAR != 0
+  pos::Atomic kernelVar;
+#endif
+}
+
+BENCH(atomicOps)
+{
+  const char* variant = var.isLockFree() ? "native" : "schedlock";
+
+  atomicOp("atomicFetchAdd", variant, [] { var.fetchAdd(1); });
+  atomicOp("atomicCas", variant, [] {
+    INT_t v = var.load(pos::MemoryRelaxed);
+    while (!var.compareExchangeWeak(v, v + 1))
+      ;
+  });
+
+#if POSCFG_FEATURE_ATOMICVAR != 0
+  kernelVar.set(0);
+  atomicOp("atomicFetchAdd", "kernel", [] { kernelVar.add(1); });
+#endif
+}
+
+BENCH(sharedRead)
+{
+  Snapshot s;
+
+  fill(s, 0);
+  done.create(0);
+  mutex.create();
+  mutexShared = s;
+  seqShared.write(s);
+
+  sharedRead("mutex", mutexReader, mutexWriter);
+  sharedRead("seqlock", seqReader, seqWriter);
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+
+#include "bench.hxx"
+
+namespace bench {
+
+  static Entry* first = NULL;
+  static Entry* last  = NULL;
+
+  static bool json = false;
+  static int selectedCount = 0;
+  static char** selected = NULL;
+
+  Entry::Entry(const char* n, Func f)
+  {
+    name = n;
+    func = f;
+    next = NULL;
+
+    if (last == NULL)
+      first = this;
+    else
+      last->next = this;
+
+    last = this;
+  }
+
+  Samples::Samples(unsigned long cap)
+  {
+    values = (Nanos*)malloc(cap * sizeof(Nanos));
+    count = 0;
+    capacity = cap;
+    sorted = false;
+  }
+
+  Samples::~Samples()
+  {
+    ::free(values);
+  }
+
+  Nanos Samples::percentile(unsigned int pct)
+  {
+    if (count == 0)
+      return 0;
+
+    if (!sorted) {
+
+      std::sort(values, values + count);
+      sorted = true;
+    }
+
+    return values[(count - 1) * pct / 100];
+  }
+
+  Nanos Samples::total() const
+  {
+    Nanos sum = 0;
+
+    for (unsigned long i = 0; i < count; ++i)
+      sum += values[i];
+
+    return sum;
+  }
+
+  Nanos now()
+  {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Nanos)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+  }
+
+  pos::Task startTask(POSTASKFUNC_t func, void* arg,
+                      VAR_t prio, const char* name)
+  {
+    nos::Task task;
+
+    if (task.create(func, arg, prio, STACK_SIZE, name) != 0) {
+
+      fprintf(stderr, "%s: task create failed\n", name);
+      exit(1);
+    }
+
+    return task;
+  }
+
+  static double opsPerSec(unsigned long ops, Nanos elapsed)
+  {
+    return elapsed > 0 ? ops / (elapsed / 1e9) : 0.0;
+  }
+
+  void report(const char* name,
+              const char* variant,
+              unsigned long ops,
+              Nanos elapsed,
+              unsigned long copied,
+              unsigned long wakeups)
+  {
+    if (json)
+      printf("{\"benchmark\":\"%s\",\"variant\":\"%s\",\"ops\":%lu,"
+             "\"ops_per_sec\":%.0f,\"bytes_copied\":%lu,\"wakeups\":%lu}\n",
+             name, variant, ops, opsPerSec(ops, elapsed), copied, wakeups);
+    else
+      printf("%s,%s,%lu,%.0f,,,,,%lu,%lu,\n",
+             name, variant, ops, opsPerSec(ops, elapsed), copied, wakeups);
+
+    fflush(stdout);
+  }
+
+  void report(const char* name,
+              const char* variant,
+              Samples& s)
+  {
+    unsigned long ops = s.size();
+    double rate = opsPerSec(ops, s.total());
+    Nanos p50 = s.percentile(50);
+    Nanos p90 = s.percentile(90);
+    Nanos p99 = s.percentile(99);
+    Nanos max = s.percentile(100);
+
+    if (json)
+      printf("{\"benchmark\":\"%s\",\"variant\":\"%s\",\"ops\":%lu,"
+             "\"ops_per_sec\":%.0f,\"p50_ns\":%llu,\"p90_ns\":%llu,"
+             "\"p99_ns\":%llu,\"max_ns\":%llu}\n",
+             name, variant, ops, rate, p50, p90, p99, max);
+    else
+      printf("%s,%s,%lu,%.0f,%llu,%llu,%llu,%llu,,,\n",
+             name, variant, ops, rate, p50, p90, p99, max);
+
+    fflush(stdout);
+  }
+
+  void reportMemory(const char* name,
+                    const char* variant,
+                    unsigned long activities,
+                    unsigned long bytes)
+  {
+    if (json)
+      printf("{\"benchmark\":\"%s\",\"variant\":\"%s\",\"ops\":%lu,"
+             "\"bytes_per_activity\":%lu}\n",
+             name, variant, activities, bytes);
+    else
+      printf("%s,%s,%lu,,,,,,,,%lu\n",
+             name, variant, activities, bytes);
+
+    fflush(stdout);
+  }
+
+  static bool isSelected(const char* name)
+  {
+    if (selectedCount == 0)
+      return true;
+
+    for (int i = 0; i < selectedCount; ++i)
+      if (strcmp(selected[i], name) == 0)
+        return true;
+
+    return false;
+  }
+
+  static void firstTask(void*)
+  {
+    if (!json)
+      printf("benchmark,variant,ops,ops_per_sec,"
+             "p50_ns,p90_ns,p99_ns,max_ns,bytes_copied,wakeups,"
+             "bytes_per_activity\n");
+
+    for (Entry* e = first; e != NULL; e = e->next)
+      if (isSelected(e->name))
+        e->func();
+
+    exit(0);
+  }
+}
+
+/*
+ * Usage: picoos-oo-bench [--json] [benchmark ...]
+ */
+int main(int argc, char** argv)
+{
+  int i = 1;
+
+  if (argc > 1 && strcmp(argv[1], "--json") == 0) {
+
+    bench::json = true;
+    ++i;
+  }
+
+  bench::selected = argv + i;
+  bench::selectedCount = argc - i;
+
+  nosInit(bench::firstTask, NULL, bench::PRIO_MAIN, bench::STACK_SIZE, 1024);
+  return 0;
+}
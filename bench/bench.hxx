@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    bench.hxx
+ * @brief   Benchmark harness for picoos-oo
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _BENCH_HXX
+#define _BENCH_HXX
+
+#include <picoos.hxx>
+
+/*
+ * Benchmarks are run on the unix port of pico]OS, so host
+ * clock is used for timing. Each benchmark is registered with
+ * BENCH macro and run by the first task in registration order.
+ * Results are printed to stdout as CSV lines, or as JSON lines
+ * when program is started with --json.
+ *
+ * Most benchmarks are run twice, through C++ wrapper (variant "oo")
+ * and through pico]OS C-api (variant "c"), so that overhead
+ * of wrapper can be seen directly.
+ */
+
+namespace bench {
+
+  typedef unsigned long long Nanos;
+
+  typedef void (*Func)();
+
+  struct Entry
+  {
+    Entry(const char* name, Func func);
+
+    const char* name;
+    Func func;
+    Entry* next;
+  };
+
+/*
+ * Latency samples of one benchmark run.
+ */
+  class Samples
+  {
+  public:
+    Samples(unsigned long capacity);
+    ~Samples();
+
+    inline void add(Nanos value)
+    {
+      if (count < capacity)
+        values[count++] = value;
+    }
+
+/*
+ * Add time elapsed since start, return current time.
+ */
+    inline Nanos lap(Nanos start, unsigned long ops = 1);
+
+/*
+ * Return given percentile (0-100) of samples.
+ */
+    Nanos percentile(unsigned int pct);
+
+    unsigned long size() const
+    {
+      return count;
+    }
+
+    Nanos total() const;
+
+  private:
+    Nanos* values;
+    unsigned long count;
+    unsigned long capacity;
+    bool sorted;
+  };
+
+/*
+ * Returns monotonic host time in nanoseconds.
+ */
+  Nanos now();
+
+  inline Nanos Samples::lap(Nanos start, unsigned long ops)
+  {
+    Nanos t = now();
+
+    add((t - start) / ops);
+    return t;
+  }
+
+/*
+ * Print throughput result. Ops is number of operations done during
+ * elapsed time, copied is number of payload bytes copied and
+ * wakeups number of blocking wait calls done by consumer.
+ */
+  void report(const char* name,
+              const char* variant,
+              unsigned long ops,
+              Nanos elapsed,
+              unsigned long copied,
+              unsigned long wakeups);
+
+/*
+ * Print latency result with percentiles.
+ */
+  void report(const char* name,
+              const char* variant,
+              Samples& samples);
+
+/*
+ * Print memory needed per concurrent activity.
+ */
+  void reportMemory(const char* name,
+                    const char* variant,
+                    unsigned long activities,
+                    unsigned long bytes);
+
+/*
+ * Task priorities used by benchmarks. Main benchmark task runs
+ * at lowest priority.
+ */
+  const VAR_t PRIO_MAIN = 1;
+  const VAR_t PRIO_LOW  = 2;
+  const VAR_t PRIO_HIGH = 3;
+
+  const UINT_t STACK_SIZE = 8192;
+
+/*
+ * Start a benchmark helper task.
+ */
+  pos::Task startTask(POSTASKFUNC_t func, void* arg,
+                      VAR_t prio, const char* name);
+}
+
+#define BENCH(n) \
+  static void bench_##n(); \
+  static bench::Entry benchEntry_##n(#n, bench_##n); \
+  static void bench_##n()
+
+#endif /* _BENCH_HXX */
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compare pos::Channel against raw pico]OS message boxes.
+ * Ping-pong measures round trips between two tasks, batch
+ * measures throughput when producer sends bursts of messages
+ * to a higher priority consumer.
+ *
+ * Wakeups are measured only for channel variant of msgBatch,
+ * where only receiveN calls that had to wait are counted.
+ * Elsewhere they are reported as ROUNDS, not measured: in ping-pong
+ * every message is a round trip, and raw consumer of msgBatch runs
+ * at higher priority than producer, so it blocks in posMessageGet
+ * once for every message.
+ */
+
+#include <string.h>
+
+#include "bench.hxx"
+
+#if POSCFG_FEATURE_MSGBOXES != 0 && POSCFG_MSG_MEMORY != 0
+
+namespace {
+
+  const unsigned long ROUNDS = 100000;
+  const UINT_t BATCH = 4;
+  const UINT_t STOP  = (UINT_t)~0;
+
+  struct Sample
+  {
+    Sample(UINT_t s) : seq(s)
+    {
+    }
+
+    UINT_t seq;
+    char data[48];
+  };
+
+  static_assert(sizeof(Sample) <= POSCFG_MSG_BUFSIZE,
+                "Sample does not fit into message buffer");
+
+  typedef pos::Channel<Sample, 16> SampleChannel;
+
+  pos::Task mainTask;
+  pos::Sema done;
+  unsigned long wakeups;
+  SampleChannel requests;
+  SampleChannel replies;
+
+  void setup()
+  {
+    static bool initialized = false;
+
+    if (initialized)
+      return;
+
+    mainTask = pos::Task::getCurrent();
+    done.create(0);
+    requests.create();
+    replies.create();
+    initialized = true;
+  }
+
+  void rawEcho(void*)
+  {
+    for (;;) {
+
+      Sample* s = (Sample*)posMessageGet();
+      if (s->seq == STOP) {
+
+        posMessageFree(s);
+        break;
+      }
+
+      posMessageSend(s, mainTask);
+    }
+  }
+
+  void channelEcho(void*)
+  {
+    for (;;) {
+
+      Sample* s = requests.receive();
+      UINT_t seq = s->seq;
+
+      requests.free(s);
+      if (seq == STOP)
+        break;
+
+      replies.send(replies.construct(seq));
+    }
+  }
+
+  void rawConsumer(void*)
+  {
+    Sample local(0);
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      void* buf = posMessageGet();
+      memcpy(&local, buf, sizeof(local));
+      posMessageFree(buf);
+    }
+
+    done.signal();
+  }
+
+  void channelConsumer(void*)
+  {
+    Sample* batch[BATCH];
+    unsigned long received = 0;
+
+    wakeups = 0;
+    while (received < ROUNDS) {
+
+      UINT_t n = requests.receiveN(batch, BATCH, 0);
+
+      if (n == 0) {
+
+        n = requests.receiveN(batch, BATCH, INFINITE);
+        ++wakeups;
+      }
+
+      for (UINT_t i = 0; i < n; ++i)
+        requests.free(batch[i]);
+
+      received += n;
+    }
+
+    done.signal();
+  }
+
+  Sample* construct(SampleChannel& ch, UINT_t seq)
+  {
+    Sample* s;
+
+    while ((s = ch.construct(seq)) == NULL)
+      pos::Task::sleep(1);
+
+    return s;
+  }
+}
+
+BENCH(msgPingPong)
+{
+  Sample local(0);
+  unsigned long copied = 0;
+  pos::Task peer;
+  bench::Nanos start;
+
+  setup();
+  peer = bench::startTask(rawEcho, NULL, bench::PRIO_HIGH, "rawecho");
+
+  start = bench::now();
+  for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+    void* buf = posMessageAlloc();
+
+    local.seq = i;
+    memcpy(buf, &local, sizeof(local));
+    posMessageSend(buf, peer);
+
+    buf = posMessageGet();
+    memcpy(&local, buf, sizeof(local));
+    posMessageFree(buf);
+    copied += 2 * sizeof(local);
+  }
+
+  bench::report("msgPingPong", "c", ROUNDS, bench::now() - start,
+                copied, ROUNDS);
+
+  local.seq = STOP;
+  void* buf = posMessageAlloc();
+  memcpy(buf, &local, sizeof(local));
+  posMessageSend(buf, peer);
+
+  bench::startTask(channelEcho, NULL, bench::PRIO_HIGH, "chanecho");
+
+  start = bench::now();
+  for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+    requests.send(construct(requests, i));
+    replies.free(replies.receive());
+  }
+
+  bench::report("msgPingPong", "channel", ROUNDS, bench::now() - start,
+                0, ROUNDS);
+  requests.send(construct(requests, STOP));
+}
+
+BENCH(msgBatch)
+{
+  Sample local(0);
+  unsigned long copied = 0;
+  pos::Task peer;
+  bench::Nanos start;
+
+  setup();
+  peer = bench::startTask(rawConsumer, NULL, bench::PRIO_HIGH, "rawcons");
+
+  start = bench::now();
+  for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+    void* buf = posMessageAlloc();
+
+    local.seq = i;
+    memcpy(buf, &local, sizeof(local));
+    posMessageSend(buf, peer);
+    copied += 2 * sizeof(local);
+  }
+
+  done.get();
+  bench::report("msgBatch", "c", ROUNDS, bench::now() - start,
+                copied, ROUNDS);
+
+  bench::startTask(channelConsumer, NULL, bench::PRIO_HIGH, "chancons");
+
+  start = bench::now();
+  for (unsigned long i = 0; i < ROUNDS; i += BATCH) {
+
+    Sample* batch[BATCH];
+
+    for (UINT_t b = 0; b < BATCH; ++b)
+      batch[b] = construct(requests, i + b);
+
+    requests.sendN(batch, BATCH);
+  }
+
+  done.get();
+  bench::report("msgBatch", "channel", ROUNDS, bench::now() - start,
+                0, wakeups);
+}
+
+#endif
@@ -0,0 +1,77 @@
+#
+# Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. The name of the author may not be used to endorse or promote
+#     products derived from this software without specific prior written
+#     permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+# INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+# OF THE POSSIBILITY OF SUCH DAMAGE.
+
+#
+# Compare sizes of oo_* and c_* function pairs in object file
+# produced from codesize.cxx. Invoked as
+#
+#   cmake -DNM=<nm> -DOBJECTS=<object files> -P codesize.cmake
+#
+
+execute_process(COMMAND ${NM} -S --defined-only ${OBJECTS}
+                OUTPUT_VARIABLE symbols
+                RESULT_VARIABLE status)
+
+if(NOT status EQUAL 0)
+  message(FATAL_ERROR "${NM} failed")
+endif()
+
+string(REPLACE "\n" ";" lines "${symbols}")
+
+foreach(line IN LISTS lines)
+  if(line MATCHES "^[0-9a-fA-F]+ +([0-9a-fA-F]+) +[tT] +_?(oo|c)_([A-Za-z0-9]+)$")
+    math(EXPR size "0x${CMAKE_MATCH_1}")
+    set(${CMAKE_MATCH_2}_${CMAKE_MATCH_3} ${size})
+    if(CMAKE_MATCH_2 STREQUAL "oo")
+      list(APPEND calls ${CMAKE_MATCH_3})
+    endif()
+  endif()
+endforeach()
+
+if(NOT calls)
+  message(FATAL_ERROR "no oo_* functions found in ${OBJECTS}")
+endif()
+
+set(failed 0)
+foreach(call IN LISTS calls)
+  if(NOT DEFINED c_${call})
+    message(FATAL_ERROR "c_${call} missing")
+  endif()
+
+  if(oo_${call} GREATER c_${call})
+    message(SEND_ERROR "${call}: wrapper ${oo_${call}} bytes, C-api ${c_${call}} bytes")
+    set(failed 1)
+  else()
+    message(STATUS "${call}: ${oo_${call}} bytes")
+  endif()
+endforeach()
+
+if(failed)
+  message(FATAL_ERROR "wrapper code size check failed")
+endif()
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Code size check. Each wrapper call is compiled into a function
+ * named oo_<call> and the corresponding C-api call into a function
+ * named c_<call>. codesize.cmake compares symbol sizes of these
+ * pairs and fails if any wrapper function is larger than its
+ * C counterpart, which means that inlining has failed or
+ * an extra indirection has been added to the wrapper.
+ */
+
+#include <picoos.hxx>
+
+#define PAIR(n, ret, ootype, ctype, oocall, ccall) \
+  extern "C" ret oo_##n(ootype obj); \
+  extern "C" ret c_##n(ctype obj); \
+  ret oo_##n(ootype obj) { return oocall; } \
+  ret c_##n(ctype obj) { return ccall; }
+
+PAIR(taskGetPriority, VAR_t, pos::Task*, POSTASK_t*,
+     obj->getPriority(), ::posTaskGetPriority(*obj))
+
+#if POSCFG_FEATURE_SEMAPHORES != 0
+PAIR(semaSignal, VAR_t, pos::Sema*, POSSEMA_t*,
+     obj->signal(), ::posSemaSignal(*obj))
+PAIR(semaGet, VAR_t, pos::Sema*, POSSEMA_t*,
+     obj->get(), ::posSemaGet(*obj))
+#if POSCFG_FEATURE_SEMAWAIT != 0
+PAIR(semaWait, VAR_t, pos::Sema*, POSSEMA_t*,
+     obj->wait(10), ::posSemaWait(*obj, 10))
+#endif
+#endif
+
+#if POSCFG_FEATURE_MUTEXES != 0
+PAIR(mutexLock, VAR_t, pos::Mutex*, POSMUTEX_t*,
+     obj->lock(), ::posMutexLock(*obj))
+PAIR(mutexUnlock, VAR_t, pos::Mutex*, POSMUTEX_t*,
+     obj->unlock(), ::posMutexUnlock(*obj))
+#if POSCFG_FEATURE_MUTEXTRYLOCK != 0
+PAIR(mutexTryLock, VAR_t, pos::Mutex*, POSMUTEX_t*,
+     obj->tryLock(), ::posMutexTryLock(*obj))
+#endif
+#endif
+
+#if POSCFG_FEATURE_FLAGS != 0
+PAIR(flagSet, VAR_t, pos::Flag*, POSFLAG_t*,
+     obj->set(1), ::posFlagSet(*obj, 1))
+PAIR(flagGet, VAR_t, pos::Flag*, POSFLAG_t*,
+     obj->get(POSFLAG_MODE_GETMASK), ::posFlagGet(*obj, POSFLAG_MODE_GETMASK))
+#endif
+
+#if POSCFG_FEATURE_ATOMICVAR != 0
+PAIR(atomicAdd, INT_t, pos::Atomic*, POSATOMIC_t*,
+     obj->add(1), ::posAtomicAdd(obj, 1))
+PAIR(atomicGet, INT_t, pos::Atomic*, POSATOMIC_t*,
+     obj->get(), ::posAtomicGet(obj))
+#endif
+
+#if POSCFG_FEATURE_TIMER != 0
+PAIR(timerStart, VAR_t, pos::Timer*, POSTIMER_t*,
+     obj->start(), ::posTimerStart(*obj))
+#endif
+
+#if POSCFG_FEATURE_MSGBOXES != 0
+PAIR(messageSend, VAR_t, pos::Message*, void**,
+     obj->send(pos::Task::getCurrent()), ::posMessageSend(*obj, ::posTaskGetCurrent()))
+PAIR(messageGet, void*, pos::Message*, void**,
+     obj->get(), (*obj = ::posMessageGet()))
+#endif
+
+#if POSCFG_FEATURE_SOFTINTS != 0
+PAIR(softIntRaise, int, UVAR_t, UVAR_t,
+     (pos::SoftInt::raise(obj, 0), 0), (::posSoftInt(obj, 0), 0))
+#endif
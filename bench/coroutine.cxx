@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compare coroutines run by pos::Executor against one task per
+ * activity. coSwitch measures round trip between two activities,
+ * coSemaWake latency from signaling a pos::Sema in another task
+ * to waiting activity running (with and without Executor::notify)
+ * and activityMemory memory needed by one activity: configured
+ * task stack size versus coroutine frame. Stack usage of tasks is
+ * not measured, so task row ("task-configured") is the stack
+ * reserved per task, not its high-water mark. coPolling checks that coroutines
+ * waiting for a semaphore or sleeping keep running without
+ * Executor::notify. Needs C++20.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.hxx"
+
+#if defined(__cpp_impl_coroutine) && POSCFG_FEATURE_SEMAWAIT != 0 && POSCFG_FEATURE_JIFFIES != 0
+
+namespace {
+
+  const unsigned long ROUNDS = 10000;
+  const unsigned long WAKE_ROUNDS = 1000;
+  const unsigned long POLLED_ROUNDS = 100;
+  const unsigned long CHECK_ROUNDS = 10;
+
+  pos::Executor executor;
+  pos::Sema done;
+  pos::Sema ping;
+  pos::Sema pong;
+  pos::CoSema coPing;
+  pos::CoSema coPong;
+  bench::Samples* samples;
+  bench::Nanos stamp;
+  volatile bool stop;
+  volatile unsigned long ticks;
+  volatile unsigned long taken;
+
+  pos::CoTask coPinger()
+  {
+    bench::Nanos t;
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      coPing.signal();
+      co_await coPong.wait();
+      samples->lap(t);
+    }
+
+    done.signal();
+  }
+
+  pos::CoTask coPonger()
+  {
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      co_await coPing.wait();
+      coPong.signal();
+    }
+  }
+
+  void ponger(void*)
+  {
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      ping.get();
+      pong.signal();
+    }
+  }
+
+  void pinger(void*)
+  {
+    bench::Nanos t;
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      ping.signal();
+      pong.get();
+      samples->lap(t);
+    }
+
+    done.signal();
+  }
+
+  pos::CoTask coWaiter(unsigned long rounds)
+  {
+    for (unsigned long i = 0; i < rounds; ++i) {
+
+      co_await pos::AwaitSema(ping);
+      samples->add(bench::now() - stamp);
+      done.signal();
+    }
+  }
+
+  void waiter(void*)
+  {
+    for (unsigned long i = 0; i < WAKE_ROUNDS; ++i) {
+
+      ping.get();
+      samples->add(bench::now() - stamp);
+      done.signal();
+    }
+  }
+
+  void wake(unsigned long rounds, bool notify)
+  {
+    for (unsigned long i = 0; i < rounds; ++i) {
+
+      stamp = bench::now();
+      ping.signal();
+      if (notify)
+        executor.notify();
+
+      done.get();
+    }
+  }
+
+  pos::CoTask sleeper()
+  {
+    while (!stop)
+      co_await pos::AwaitSleep(1);
+  }
+
+  pos::CoTask ticker()
+  {
+    while (!stop) {
+
+      co_await pos::AwaitSleep(1);
+      ticks = ticks + 1;
+    }
+  }
+
+  pos::CoTask taker(unsigned long rounds)
+  {
+    for (unsigned long i = 0; i < rounds; ++i) {
+
+      co_await pos::AwaitSema(ping);
+      taken = taken + 1;
+    }
+  }
+
+/*
+ * Wait until cond returns true, fail benchmark if it
+ * doesn't happen within a second.
+ */
+  void expect(bool (*cond)(), const char* what)
+  {
+    for (UINT_t i = 0; i < HZ && !cond(); ++i)
+      pos::Task::sleep(1);
+
+    if (!cond()) {
+
+      printf("coPolling: %s\n", what);
+      exit(1);
+    }
+  }
+
+/*
+ * Create semaphores and start executor task once, so that
+ * benchmarks can be selected one by one.
+ */
+  void setup()
+  {
+    static bool started = false;
+
+    if (started)
+      return;
+
+    done.create(0);
+    ping.create(0);
+    pong.create(0);
+    executor.create();
+    bench::startTask(pos::Executor::task, &executor, bench::PRIO_HIGH, "executor");
+    started = true;
+  }
+
+  void sleeperTask(void*)
+  {
+    while (!stop)
+      pos::Task::sleep(1);
+  }
+}
+
+BENCH(coSwitch)
+{
+  bench::Samples taskSamples(ROUNDS);
+  bench::Samples coSamples(ROUNDS);
+
+  setup();
+
+  samples = &taskSamples;
+  bench::startTask(ponger, NULL, bench::PRIO_HIGH, "ponger");
+  bench::startTask(pinger, NULL, bench::PRIO_HIGH, "pinger");
+  done.get();
+  bench::report("coSwitch", "task", taskSamples);
+
+  samples = &coSamples;
+  executor.spawn(coPonger());
+  executor.spawn(coPinger());
+  done.get();
+  bench::report("coSwitch", "coroutine", coSamples);
+}
+
+BENCH(coSemaWake)
+{
+  bench::Samples taskSamples(WAKE_ROUNDS);
+  bench::Samples notifySamples(WAKE_ROUNDS);
+  bench::Samples polledSamples(POLLED_ROUNDS);
+
+  setup();
+  samples = &taskSamples;
+  bench::startTask(waiter, NULL, bench::PRIO_HIGH, "waiter");
+  wake(WAKE_ROUNDS, false);
+  bench::report("coSemaWake", "task", taskSamples);
+
+  samples = &notifySamples;
+  executor.spawn(coWaiter(WAKE_ROUNDS));
+  wake(WAKE_ROUNDS, true);
+  bench::report("coSemaWake", "coroutine-notify", notifySamples);
+
+  samples = &polledSamples;
+  executor.spawn(coWaiter(POLLED_ROUNDS));
+  wake(POLLED_ROUNDS, false);
+  bench::report("coSemaWake", "coroutine-polled", polledSamples);
+}
+
+BENCH(coPolling)
+{
+  static unsigned long target;
+  bench::Nanos start;
+
+  setup();
+  taken = 0;
+  executor.spawn(taker(CHECK_ROUNDS));
+  start = bench::now();
+  for (unsigned long i = 0; i < CHECK_ROUNDS; ++i) {
+
+    target = i + 1;
+    ping.signal();
+    expect([] { return taken >= target; }, "polled semaphore wait stalled");
+  }
+
+  expect([] { return executor.count() == 0; }, "semaphore waiter did not finish");
+  bench::report("coPolling", "sema", CHECK_ROUNDS, bench::now() - start, 0, 0);
+
+  stop = false;
+  ticks = 0;
+  executor.spawn(ticker());
+  start = bench::now();
+  for (unsigned long i = 0; i < CHECK_ROUNDS; ++i) {
+
+    target = ticks + 1;
+    expect([] { return ticks >= target; }, "periodic sleep stalled");
+  }
+
+  bench::report("coPolling", "sleep", CHECK_ROUNDS, bench::now() - start, 0, 0);
+  stop = true;
+  expect([] { return executor.count() == 0; }, "sleeper did not finish");
+}
+
+BENCH(activityMemory)
+{
+  const UINT_t activities = OOCFG_CORO_FRAMES / 2;
+  UINT_t spawned = 0;
+
+  setup();
+  stop = false;
+  for (UINT_t i = 0; i < activities; ++i)
+    bench::startTask(sleeperTask, NULL, bench::PRIO_HIGH, "sleeper");
+
+  bench::reportMemory("activityMemory", "task-configured", activities, bench::STACK_SIZE);
+
+  for (UINT_t i = 0; i < activities; ++i)
+    if (executor.spawn(sleeper()))
+      ++spawned;
+
+  pos::Task::sleep(2);
+  bench::reportMemory("activityMemory", "coroutine-slot", spawned, pos::CoFrames::slotSize());
+  bench::reportMemory("activityMemory", "coroutine-frame", spawned, pos::CoFrames::largest());
+
+  stop = true;
+  while (executor.count() > 0)
+    pos::Task::sleep(1);
+}
+
+#endif
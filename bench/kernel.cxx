@@ -0,0 +1,611 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Kernel primitive benchmarks. Each benchmark is a template
+ * instantiated with two api adapters: OO calls C++ wrapper methods
+ * and C calls pico]OS C-api directly. As the wrapper is supposed
+ * to compile into direct C-api calls, results of both variants
+ * should be equal within measurement noise.
+ */
+
+#include <stdlib.h>
+
+#include "bench.hxx"
+
+namespace {
+
+  const unsigned long ROUNDS = 20000;
+  const unsigned long BATCH = 100;
+  const unsigned long TIMER_ROUNDS = 200;
+  const UVAR_t STOP = 1;
+
+/*
+ * Kernel objects are destroyed only if pico]OS is configured
+ * to support it.
+ */
+  struct OO
+  {
+    static const char* name() { return "oo"; }
+
+    static void yield()
+    {
+      pos::Task::yield();
+    }
+
+    typedef pos::Sema Sema;
+
+    static void create(Sema& s) { s.create(0); }
+    static void destroy(Sema& s)
+    {
+#if POSCFG_FEATURE_SEMADESTROY != 0
+      s.destroy();
+#endif
+    }
+
+    static void signal(Sema& s) { s.signal(); }
+    static void get(Sema& s) { s.get(); }
+
+    typedef pos::Mutex Mutex;
+
+    static void create(Mutex& m) { m.create(); }
+    static void destroy(Mutex& m)
+    {
+#if POSCFG_FEATURE_MUTEXDESTROY != 0
+      m.destroy();
+#endif
+    }
+
+    static void lock(Mutex& m) { m.lock(); }
+    static void unlock(Mutex& m) { m.unlock(); }
+
+    typedef pos::Flag Flag;
+
+    static void create(Flag& f) { f.create(); }
+    static void destroy(Flag& f)
+    {
+#if POSCFG_FEATURE_FLAGDESTROY != 0
+      f.destroy();
+#endif
+    }
+
+    static void set(Flag& f, UVAR_t n) { f.set(n); }
+    static VAR_t get(Flag& f) { return f.get(POSFLAG_MODE_GETSINGLE); }
+
+    typedef pos::Atomic Atomic;
+
+    static void set(Atomic& a, INT_t v) { a.set(v); }
+    static void add(Atomic& a, INT_t v) { a.add(v); }
+
+    typedef pos::Timer Timer;
+
+    static void create(Timer& t) { t.create(); }
+    static void destroy(Timer& t)
+    {
+#if POSCFG_FEATURE_TIMERDESTROY != 0
+      t.destroy();
+#endif
+    }
+
+    static void start(Timer& t, Sema& s, UINT_t period)
+    {
+      t.set(s, period, period);
+      t.start();
+    }
+
+    static void stop(Timer& t) { t.stop(); }
+
+#if POSCFG_FEATURE_MSGBOXES != 0 && POSCFG_MSG_MEMORY != 0
+    typedef pos::Message Msg;
+
+    static void alloc(Msg& m) { m.alloc(); }
+    static void send(Msg& m, const pos::Task& t) { m.send(t); }
+    static void receive(Msg& m) { m.get(); }
+    static void free(Msg& m) { m.free(); }
+#endif
+  };
+
+  struct C
+  {
+    static const char* name() { return "c"; }
+
+    static void yield()
+    {
+      ::posTaskYield();
+    }
+
+    typedef POSSEMA_t Sema;
+
+    static void create(Sema& s) { s = ::posSemaCreate(0); }
+    static void destroy(Sema& s)
+    {
+#if POSCFG_FEATURE_SEMADESTROY != 0
+      ::posSemaDestroy(s);
+#endif
+    }
+
+    static void signal(Sema& s) { ::posSemaSignal(s); }
+    static void get(Sema& s) { ::posSemaGet(s); }
+
+    typedef POSMUTEX_t Mutex;
+
+    static void create(Mutex& m) { m = ::posMutexCreate(); }
+    static void destroy(Mutex& m)
+    {
+#if POSCFG_FEATURE_MUTEXDESTROY != 0
+      ::posMutexDestroy(m);
+#endif
+    }
+
+    static void lock(Mutex& m) { ::posMutexLock(m); }
+    static void unlock(Mutex& m) { ::posMutexUnlock(m); }
+
+    typedef POSFLAG_t Flag;
+
+    static void create(Flag& f) { f = ::posFlagCreate(); }
+    static void destroy(Flag& f)
+    {
+#if POSCFG_FEATURE_FLAGDESTROY != 0
+      ::posFlagDestroy(f);
+#endif
+    }
+
+    static void set(Flag& f, UVAR_t n) { ::posFlagSet(f, n); }
+    static VAR_t get(Flag& f) { return ::posFlagGet(f, POSFLAG_MODE_GETSINGLE); }
+
+    typedef POSATOMIC_t Atomic;
+
+    static void set(Atomic& a, INT_t v) { ::posAtomicSet(&a, v); }
+    static void add(Atomic& a, INT_t v) { ::posAtomicAdd(&a, v); }
+
+    typedef POSTIMER_t Timer;
+
+    static void create(Timer& t) { t = ::posTimerCreate(); }
+    static void destroy(Timer& t)
+    {
+#if POSCFG_FEATURE_TIMERDESTROY != 0
+      ::posTimerDestroy(t);
+#endif
+    }
+
+    static void start(Timer& t, Sema& s, UINT_t period)
+    {
+      ::posTimerSet(t, s, period, period);
+      ::posTimerStart(t);
+    }
+
+    static void stop(Timer& t) { ::posTimerStop(t); }
+
+#if POSCFG_FEATURE_MSGBOXES != 0 && POSCFG_MSG_MEMORY != 0
+    typedef void* Msg;
+
+    static void alloc(Msg& m) { m = ::posMessageAlloc(); }
+    static void send(Msg& m, const pos::Task& t) { ::posMessageSend(m, t); }
+    static void receive(Msg& m) { m = ::posMessageGet(); }
+    static void free(Msg& m) { ::posMessageFree(m); }
+#endif
+  };
+
+/*
+ * Objects shared by benchmark and its helper task.
+ */
+  template<class Api>
+  struct Shared
+  {
+    typename Api::Sema ping;
+    typename Api::Sema pong;
+    typename Api::Mutex mutex;
+    typename Api::Flag flagA;
+    typename Api::Flag flagB;
+    pos::Task main;
+    volatile UVAR_t stop;
+  };
+
+/*
+ * Task switch: two tasks of same priority yield to each other.
+ */
+  template<class Api>
+  void yieldPeer(void* arg)
+  {
+    Shared<Api>* sh = (Shared<Api>*)arg;
+
+    while (!sh->stop)
+      Api::yield();
+
+    Api::signal(sh->pong);
+  }
+
+  template<class Api>
+  void contextSwitch()
+  {
+    Shared<Api> sh;
+    bench::Samples samples(ROUNDS);
+    bench::Nanos t;
+
+    sh.stop = 0;
+    Api::create(sh.pong);
+    bench::startTask(yieldPeer<Api>, &sh, bench::PRIO_MAIN, "yield");
+
+    t = bench::now();
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      Api::yield();
+      t = samples.lap(t, 2);
+    }
+
+    sh.stop = STOP;
+    Api::get(sh.pong);
+    bench::report("contextSwitch", Api::name(), samples);
+    Api::destroy(sh.pong);
+  }
+
+/*
+ * Semaphore ping-pong between main task and a higher priority task.
+ */
+  template<class Api>
+  void semaEcho(void* arg)
+  {
+    Shared<Api>* sh = (Shared<Api>*)arg;
+
+    for (;;) {
+
+      Api::get(sh->ping);
+      if (sh->stop)
+        break;
+
+      Api::signal(sh->pong);
+    }
+
+    Api::signal(sh->pong);
+  }
+
+  template<class Api>
+  void semaPingPong()
+  {
+    Shared<Api> sh;
+    bench::Samples samples(ROUNDS);
+    bench::Nanos t;
+
+    sh.stop = 0;
+    Api::create(sh.ping);
+    Api::create(sh.pong);
+    bench::startTask(semaEcho<Api>, &sh, bench::PRIO_HIGH, "semaecho");
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      Api::signal(sh.ping);
+      Api::get(sh.pong);
+      samples.lap(t);
+    }
+
+    sh.stop = STOP;
+    Api::signal(sh.ping);
+    Api::get(sh.pong);
+    bench::report("semaPingPong", Api::name(), samples);
+    Api::destroy(sh.ping);
+    Api::destroy(sh.pong);
+  }
+
+/*
+ * Mutex lock and unlock without contention.
+ */
+  template<class Api>
+  void mutexUncontended()
+  {
+    typename Api::Mutex mutex;
+    bench::Samples samples(ROUNDS);
+    bench::Nanos t;
+
+    Api::create(mutex);
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      for (unsigned long b = 0; b < BATCH; ++b) {
+
+        Api::lock(mutex);
+        Api::unlock(mutex);
+      }
+
+      samples.lap(t, BATCH);
+    }
+
+    bench::report("mutexUncontended", Api::name(), samples);
+    Api::destroy(mutex);
+  }
+
+/*
+ * Mutex handoff: higher priority task blocks on mutex held
+ * by main task and gets it when main task unlocks.
+ */
+  template<class Api>
+  void mutexContender(void* arg)
+  {
+    Shared<Api>* sh = (Shared<Api>*)arg;
+
+    for (;;) {
+
+      Api::get(sh->ping);
+      if (sh->stop)
+        break;
+
+      Api::lock(sh->mutex);
+      Api::unlock(sh->mutex);
+      Api::signal(sh->pong);
+    }
+
+    Api::signal(sh->pong);
+  }
+
+  template<class Api>
+  void mutexContended()
+  {
+    Shared<Api> sh;
+    bench::Samples samples(ROUNDS);
+    bench::Nanos t;
+
+    sh.stop = 0;
+    Api::create(sh.ping);
+    Api::create(sh.pong);
+    Api::create(sh.mutex);
+    bench::startTask(mutexContender<Api>, &sh, bench::PRIO_HIGH, "contender");
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      Api::lock(sh.mutex);
+      Api::signal(sh.ping);
+      t = bench::now();
+      Api::unlock(sh.mutex);
+      Api::get(sh.pong);
+      samples.lap(t);
+    }
+
+    sh.stop = STOP;
+    Api::signal(sh.ping);
+    Api::get(sh.pong);
+    bench::report("mutexContended", Api::name(), samples);
+    Api::destroy(sh.ping);
+    Api::destroy(sh.pong);
+    Api::destroy(sh.mutex);
+  }
+
+#if POSCFG_FEATURE_MSGBOXES != 0 && POSCFG_MSG_MEMORY != 0
+/*
+ * Message round trip between main task and a higher priority task.
+ */
+  template<class Api>
+  void messageEcho(void* arg)
+  {
+    Shared<Api>* sh = (Shared<Api>*)arg;
+    typename Api::Msg msg;
+
+    for (;;) {
+
+      Api::receive(msg);
+      if (sh->stop)
+        break;
+
+      Api::send(msg, sh->main);
+    }
+
+    Api::free(msg);
+    Api::signal(sh->pong);
+  }
+
+  template<class Api>
+  void messageRoundTrip()
+  {
+    Shared<Api> sh;
+    bench::Samples samples(ROUNDS);
+    typename Api::Msg msg;
+    pos::Task peer;
+    bench::Nanos t;
+
+    sh.stop = 0;
+    sh.main = pos::Task::getCurrent();
+    Api::create(sh.pong);
+    peer = bench::startTask(messageEcho<Api>, &sh, bench::PRIO_HIGH, "msgecho");
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      Api::alloc(msg);
+      Api::send(msg, peer);
+      Api::receive(msg);
+      Api::free(msg);
+      samples.lap(t);
+    }
+
+    sh.stop = STOP;
+    Api::alloc(msg);
+    Api::send(msg, peer);
+    Api::get(sh.pong);
+    bench::report("messageRoundTrip", Api::name(), samples);
+    Api::destroy(sh.pong);
+  }
+#endif
+
+/*
+ * Flag set by main task, waited by higher priority task
+ * which answers with another flag.
+ */
+  template<class Api>
+  void flagWaiter(void* arg)
+  {
+    Shared<Api>* sh = (Shared<Api>*)arg;
+
+    for (;;) {
+
+      Api::get(sh->flagA);
+      if (sh->stop)
+        break;
+
+      Api::set(sh->flagB, 0);
+    }
+
+    Api::signal(sh->pong);
+  }
+
+  template<class Api>
+  void flagSetWait()
+  {
+    Shared<Api> sh;
+    bench::Samples samples(ROUNDS);
+    bench::Nanos t;
+
+    sh.stop = 0;
+    Api::create(sh.flagA);
+    Api::create(sh.flagB);
+    Api::create(sh.pong);
+    bench::startTask(flagWaiter<Api>, &sh, bench::PRIO_HIGH, "flagwait");
+
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      Api::set(sh.flagA, 0);
+      Api::get(sh.flagB);
+      samples.lap(t);
+    }
+
+    sh.stop = STOP;
+    Api::set(sh.flagA, 0);
+    Api::get(sh.pong);
+    bench::report("flagSetWait", Api::name(), samples);
+    Api::destroy(sh.flagA);
+    Api::destroy(sh.flagB);
+    Api::destroy(sh.pong);
+  }
+
+/*
+ * Atomic add.
+ */
+  template<class Api>
+  void atomicAdd()
+  {
+    typename Api::Atomic var;
+    bench::Samples samples(ROUNDS);
+    bench::Nanos t;
+
+    Api::set(var, 0);
+    for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+      t = bench::now();
+      for (unsigned long b = 0; b < BATCH; ++b)
+        Api::add(var, 1);
+
+      samples.lap(t, BATCH);
+    }
+
+    bench::report("atomicAdd", Api::name(), samples);
+  }
+
+/*
+ * Timer jitter: deviation of periodic timer wakeups
+ * from nominal period of one tick.
+ */
+  template<class Api>
+  void timerJitter()
+  {
+    typename Api::Timer timer;
+    typename Api::Sema sema;
+    bench::Samples samples(TIMER_ROUNDS);
+    const bench::Nanos period = 1000000000ULL / HZ;
+    bench::Nanos t, prev;
+
+    Api::create(sema);
+    Api::create(timer);
+    Api::start(timer, sema, 1);
+
+    Api::get(sema);
+    prev = bench::now();
+    for (unsigned long i = 0; i < TIMER_ROUNDS; ++i) {
+
+      Api::get(sema);
+      t = bench::now();
+      samples.add(t - prev > period ? t - prev - period : period - (t - prev));
+      prev = t;
+    }
+
+    Api::stop(timer);
+    bench::report("timerJitter", Api::name(), samples);
+    Api::destroy(timer);
+    Api::destroy(sema);
+  }
+}
+
+BENCH(contextSwitch)
+{
+  contextSwitch<OO>();
+  contextSwitch<C>();
+}
+
+BENCH(semaPingPong)
+{
+  semaPingPong<OO>();
+  semaPingPong<C>();
+}
+
+BENCH(mutexUncontended)
+{
+  mutexUncontended<OO>();
+  mutexUncontended<C>();
+}
+
+BENCH(mutexContended)
+{
+  mutexContended<OO>();
+  mutexContended<C>();
+}
+
+#if POSCFG_FEATURE_MSGBOXES != 0 && POSCFG_MSG_MEMORY != 0
+BENCH(messageRoundTrip)
+{
+  messageRoundTrip<OO>();
+  messageRoundTrip<C>();
+}
+#endif
+
+BENCH(flagSetWait)
+{
+  flagSetWait<OO>();
+  flagSetWait<C>();
+}
+
+BENCH(atomicAdd)
+{
+  atomicAdd<OO>();
+  atomicAdd<C>();
+}
+
+BENCH(timerJitter)
+{
+  timerJitter<OO>();
+  timerJitter<C>();
+}
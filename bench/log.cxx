@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Measure cost of writing a record to nos::Log with NOS_LOG,
+ * which checks format string against arguments at compile time.
+ * Variant "stored" writes into an empty buffer, "dropped" into
+ * a full one. Nothing is printed, so records are not drained.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.hxx"
+
+#if NOSCFG_FEATURE_CONOUT != 0 && POSCFG_FEATURE_SEMAPHORES != 0
+
+namespace {
+
+  const unsigned long ROUNDS = 1000;
+  const UINT_t BATCH = OOCFG_LOG_RECORDS;
+
+  const char* const name = "bench";
+  long value = -123456789L;
+  unsigned long counter;
+
+  inline void write(nos::Log& log, UINT_t i)
+  {
+    NOS_LOG(log, "%s %u %ld %lu\n", name, i, value, counter);
+  }
+
+/*
+ * Log object is constructed for each batch,
+ * so every write finds a free record.
+ */
+  bench::Nanos storeBatch()
+  {
+    nos::Log log;
+    bench::Nanos start = bench::now();
+
+    for (UINT_t i = 0; i < BATCH; ++i)
+      write(log, i);
+
+    start = bench::now() - start;
+    if (log.dropped() != 0) {
+
+      printf("logWrite: %u records dropped\n", log.dropped());
+      exit(1);
+    }
+
+    return start / BATCH;
+  }
+}
+
+BENCH(logWrite)
+{
+  bench::Samples stored(ROUNDS);
+  bench::Samples dropped(ROUNDS);
+  static nos::Log full;
+  bench::Nanos t;
+
+  for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+    ++counter;
+    stored.add(storeBatch());
+  }
+
+  bench::report("logWrite", "stored", stored);
+
+  for (UINT_t i = 0; i < BATCH; ++i)
+    write(full, i);
+
+  for (unsigned long i = 0; i < ROUNDS; ++i) {
+
+    t = bench::now();
+    for (UINT_t b = 0; b < BATCH; ++b)
+      write(full, b);
+
+    dropped.lap(t, BATCH);
+  }
+
+  if (full.dropped() != ROUNDS * BATCH) {
+
+    printf("logWrite: expected %lu dropped records, got %u\n",
+           ROUNDS * BATCH, full.dropped());
+    exit(1);
+  }
+
+  bench::report("logWrite", "dropped", dropped);
+}
+
+#endif
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Exercise pos::Ring with a software interrupt producer.
+ *
+ * ringSoftInt compares wakeup-on-transition against signaling
+ * a semaphore for each item. Higher priority consumer drains every
+ * burst completely, so this measures throughput only.
+ *
+ * ringStress makes producer outrun consumer. Producer task runs
+ * at higher priority and wakes up every tick, so it preempts
+ * the consumer at arbitrary points, also in the middle of peek/consume
+ * and between the consumer's empty check and its wait. Every fourth
+ * burst is twice the ring size, so the ring-full path is always
+ * taken. Consumer waits with a long timeout. A timeout while producer
+ * is still running means a lost wakeup and fails the benchmark. So does
+ * an item out of order or a run where the ring never became full.
+ * Semaphore policy is run with high-water marks 1 and SIZE / 4,
+ * flag policy with 1. Number of push retries on a full ring
+ * is printed to stderr.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.hxx"
+
+#if POSCFG_FEATURE_SOFTINTS != 0
+
+namespace {
+
+  const UINT_t ITEMS = 1000000;
+  const UVAR_t BURST = 16;
+  const UVAR_t INTNO = 0;
+  const UINT_t SIZE = 256;
+
+  const UINT_t STRESS_ITEMS = 50000;
+  const UINT_t STRESS_SMALL = 16;
+  const UINT_t STALL = HZ / 2;
+  const unsigned long WORK = 200;
+
+  pos::Ring<UINT_t, SIZE, pos::RingSemaWakeup> batchRing;
+  pos::Ring<UINT_t, SIZE> itemRing;
+
+  pos::Sema ready;
+  pos::Sema done;
+  volatile UINT_t produced;
+  unsigned long wakeups;
+  unsigned long retries;
+
+/*
+ * Handler is installed only once and benchmarks
+ * switch the function it calls.
+ */
+  POSINTFUNC_t current;
+
+  void dispatch(UVAR_t arg)
+  {
+    current(arg);
+  }
+
+  void setHandler(POSINTFUNC_t handler)
+  {
+    static bool installed = false;
+
+    current = handler;
+    if (!installed) {
+
+      if (pos::SoftInt::setHandler(INTNO, dispatch) != 0) {
+
+        printf("ring: cannot set softint handler\n");
+        exit(1);
+      }
+
+      installed = true;
+    }
+  }
+
+/*
+ * Create semaphores once, so that benchmarks
+ * can be run in any combination.
+ */
+  void setup()
+  {
+    static bool created = false;
+
+    if (created)
+      return;
+
+    ready.create(0);
+    done.create(0);
+    batchRing.setWakeup(ready);
+    created = true;
+  }
+
+  void check(UINT_t value, UINT_t& expect)
+  {
+    if (value != expect) {
+
+      printf("ring: expected %u, got %u\n", expect, value);
+      exit(1);
+    }
+
+    ++expect;
+  }
+
+  void batchHandler(UVAR_t n)
+  {
+    while (n-- > 0 && produced < ITEMS) {
+
+      if (batchRing.push((UINT_t)produced) != 0) {
+
+        ++retries;
+        break;
+      }
+
+      produced = produced + 1;
+    }
+  }
+
+  void itemHandler(UVAR_t n)
+  {
+    while (n-- > 0 && produced < ITEMS) {
+
+      if (itemRing.push((UINT_t)produced) != 0) {
+
+        ++retries;
+        break;
+      }
+
+      produced = produced + 1;
+      ready.signal();
+    }
+  }
+
+  void batchConsumer(void*)
+  {
+    UINT_t expect = 0;
+    UINT_t* data;
+    UINT_t n;
+
+    while (expect < ITEMS) {
+
+      batchRing.wait(INFINITE);
+      ++wakeups;
+      while ((n = batchRing.peek(data)) > 0) {
+
+        for (UINT_t i = 0; i < n; ++i)
+          check(data[i], expect);
+
+        batchRing.consume(n);
+      }
+    }
+
+    done.signal();
+  }
+
+  void itemConsumer(void*)
+  {
+    UINT_t expect = 0;
+    UINT_t value;
+
+    while (expect < ITEMS) {
+
+      ready.get();
+      ++wakeups;
+      if (itemRing.pop(value) == 0)
+        check(value, expect);
+    }
+
+    done.signal();
+  }
+
+  void run(const char* variant, POSINTFUNC_t handler, POSTASKFUNC_t consumer)
+  {
+    bench::Nanos start;
+
+    produced = 0;
+    wakeups = 0;
+    retries = 0;
+    setHandler(handler);
+    bench::startTask(consumer, NULL, bench::PRIO_HIGH, variant);
+
+    start = bench::now();
+    while (produced < ITEMS) {
+
+      pos::SoftInt::raise(INTNO, BURST);
+      pos::Task::yield();
+    }
+
+    done.get();
+    bench::report("ringSoftInt", variant, ITEMS, bench::now() - start,
+                  0, wakeups);
+    if (retries != 0)
+      fprintf(stderr, "ringSoftInt,%s: %lu retries\n", variant, retries);
+  }
+
+/*
+ * Stress variants. Each has its own ring and a wait
+ * function that returns nonzero on timeout. Both use
+ * pos::Ring::wait, which fences before checking if ring is empty.
+ */
+#if POSCFG_FEATURE_SEMAWAIT != 0
+
+  struct SemaStress
+  {
+    typedef pos::Ring<UINT_t, SIZE, pos::RingSemaWakeup> Ring;
+
+    static Ring ring;
+
+    static VAR_t wait(UINT_t timeout)
+    {
+      return ring.wait(timeout);
+    }
+  };
+
+  SemaStress::Ring SemaStress::ring;
+
+#endif
+
+#if POSCFG_FEATURE_FLAGS != 0 && POSCFG_FEATURE_FLAGWAIT != 0
+
+  struct FlagStress
+  {
+    typedef pos::Ring<UINT_t, SIZE, pos::RingFlagWakeup> Ring;
+
+    static Ring ring;
+    static pos::Flag flag;
+
+    static VAR_t wait(UINT_t timeout)
+    {
+      return ring.wait(timeout);
+    }
+  };
+
+  FlagStress::Ring FlagStress::ring;
+  pos::Flag FlagStress::flag;
+
+#endif
+
+  volatile unsigned long sink;
+
+  void work()
+  {
+    for (unsigned long i = 0; i < WORK; ++i)
+      sink = sink + i;
+  }
+
+/*
+ * Argument tells if this is a large burst.
+ */
+  template<class V>
+  void stressHandler(UVAR_t large)
+  {
+    UINT_t n = large ? 2 * SIZE : STRESS_SMALL;
+
+    while (n-- > 0 && produced < STRESS_ITEMS) {
+
+      if (V::ring.push((UINT_t)produced) != 0) {
+
+        ++retries;
+        break;
+      }
+
+      produced = produced + 1;
+    }
+  }
+
+  void stressProducer(void*)
+  {
+    UINT_t tick = 0;
+
+    while (produced < STRESS_ITEMS) {
+
+      pos::Task::sleep(1);
+      pos::SoftInt::raise(INTNO, (tick++ % 4) == 0);
+    }
+
+    done.signal();
+  }
+
+  template<class V>
+  void stressConsumer(void*)
+  {
+    UINT_t expect = 0;
+    UINT_t* data;
+    UINT_t n;
+
+    while (expect < STRESS_ITEMS) {
+
+      if (V::wait(STALL) != 0 && produced < STRESS_ITEMS) {
+
+        printf("ringStress: lost wakeup, %u items in ring\n", V::ring.size());
+        exit(1);
+      }
+
+      ++wakeups;
+      while ((n = V::ring.peek(data)) > 0) {
+
+        for (UINT_t i = 0; i < n; ++i) {
+
+          check(data[i], expect);
+          work();
+        }
+
+        V::ring.consume(n);
+      }
+    }
+
+    done.signal();
+  }
+
+  template<class V>
+  void stress(const char* variant)
+  {
+    bench::Nanos start;
+
+    produced = 0;
+    wakeups = 0;
+    retries = 0;
+    setHandler(stressHandler<V>);
+
+    start = bench::now();
+    bench::startTask(stressConsumer<V>, NULL, bench::PRIO_LOW, variant);
+    bench::startTask(stressProducer, NULL, bench::PRIO_HIGH, "producer");
+    done.get();
+    done.get();
+
+    bench::report("ringStress", variant, STRESS_ITEMS, bench::now() - start,
+                  0, wakeups);
+    fprintf(stderr, "ringStress,%s: %lu retries\n", variant, retries);
+    if (retries == 0) {
+
+      printf("ringStress: ring never became full\n");
+      exit(1);
+    }
+  }
+}
+
+BENCH(ringSoftInt)
+{
+  setup();
+
+  run("sema-per-item", itemHandler, itemConsumer);
+  run("ring", batchHandler, batchConsumer);
+}
+
+BENCH(ringStress)
+{
+  setup();
+
+#if POSCFG_FEATURE_SEMAWAIT != 0
+  pos::Sema sema;
+
+  sema.create(0);
+  SemaStress::ring.setWakeup(sema);
+  stress<SemaStress>("sema");
+
+  while (sema.wait(0) == 0)
+    ;
+
+  SemaStress::ring.setWakeup(sema, SIZE / 4);
+  stress<SemaStress>("sema-highwater");
+#endif
+
+#if POSCFG_FEATURE_FLAGS != 0 && POSCFG_FEATURE_FLAGWAIT != 0
+  FlagStress::flag.create();
+  FlagStress::ring.setWakeup(FlagStress::flag, 0);
+  stress<FlagStress>("flag");
+#endif
+}
+
+#endif
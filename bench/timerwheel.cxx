@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Compare pos::TimerWheel against one kernel timer per timeout.
+ * Arm, re-arm and cancel costs are measured with 10k timers.
+ * Expiry lateness is measured by recording how long after its
+ * deadline each callback runs. Number of kernel timers is limited
+ * by POSCFG_MAX_TIMER, so native variant uses as many as
+ * the kernel configuration allows, and is skipped if there are
+ * no timers left beyond RESERVED_TIMERS. Kernel timers can only signal
+ * a semaphore, so native expiry task must scan timers to find
+ * out which ones have fired.
+ */
+
+#include <stdio.h>
+
+#include "bench.hxx"
+
+/*
+ * Native variant needs a few more kernel timers than
+ * are reserved for wheel and rest of the system.
+ */
+#define RESERVED_TIMERS 4
+
+#define NATIVE_TIMERS (POSCFG_FEATURE_TIMERDESTROY != 0 && \
+                       POSCFG_FEATURE_TIMERFIRED != 0 && \
+                       POSCFG_MAX_TIMER > RESERVED_TIMERS)
+
+#if POSCFG_FEATURE_TIMER != 0 && POSCFG_FEATURE_SEMAPHORES != 0 && POSCFG_FEATURE_JIFFIES != 0
+
+namespace {
+
+  const UINT_t ENTRIES = 10000;
+  const UINT_t ROUNDS = 20;
+  const UINT_t SPREAD = HZ / 2;
+
+  const bench::Nanos PERIOD = 1000000000ULL / HZ;
+
+  struct Timeout
+  {
+    pos::TimerWheel::Entry entry;
+    bench::Nanos deadline;
+  };
+
+  pos::TimerWheel wheel;
+  Timeout timeouts[ENTRIES];
+  bench::Samples* lateness;
+  UINT_t pending;
+  pos::Sema done;
+
+  void late(bench::Nanos deadline)
+  {
+    bench::Nanos t = bench::now();
+
+    lateness->add(t > deadline ? t - deadline : 0);
+  }
+
+  void expired(void* arg)
+  {
+    Timeout* t = static_cast<Timeout*>(arg);
+
+    late(t->deadline);
+    --pending;
+  }
+
+  void wheelTask(void*)
+  {
+    while (pending > 0)
+      wheel.process();
+
+    done.signal();
+  }
+
+  void wheelArm()
+  {
+    bench::Nanos start;
+
+    start = bench::now();
+    for (UINT_t r = 0; r < ROUNDS; ++r) {
+
+      for (UINT_t i = 0; i < ENTRIES; ++i)
+        wheel.arm(timeouts[i].entry, HZ + i % SPREAD);
+
+      for (UINT_t i = 0; i < ENTRIES; ++i)
+        wheel.cancel(timeouts[i].entry);
+    }
+
+    bench::report("timerArm", "wheel", 2 * ROUNDS * ENTRIES,
+                  bench::now() - start, 0, 0);
+
+    for (UINT_t i = 0; i < ENTRIES; ++i)
+      wheel.arm(timeouts[i].entry, HZ + i % SPREAD);
+
+    start = bench::now();
+    for (UINT_t r = 0; r < ROUNDS; ++r)
+      for (UINT_t i = 0; i < ENTRIES; ++i)
+        wheel.arm(timeouts[i].entry, HZ + (i + r) % SPREAD);
+
+    bench::report("timerRearm", "wheel", ROUNDS * ENTRIES,
+                  bench::now() - start, 0, 0);
+
+    for (UINT_t i = 0; i < ENTRIES; ++i)
+      wheel.cancel(timeouts[i].entry);
+  }
+
+  void wheelExpiry()
+  {
+    bench::Samples samples(ENTRIES);
+    bench::Nanos start;
+
+    lateness = &samples;
+    pending = ENTRIES;
+    start = bench::now();
+    for (UINT_t i = 0; i < ENTRIES; ++i) {
+
+      timeouts[i].deadline = start + (1 + i % SPREAD) * PERIOD;
+      wheel.arm(timeouts[i].entry, 1 + i % SPREAD);
+    }
+
+    bench::startTask(wheelTask, NULL, bench::PRIO_HIGH, "wheel");
+    done.get();
+    bench::report("timerExpiry", "wheel", samples);
+  }
+
+#if NATIVE_TIMERS
+
+/*
+ * Leave a few kernel timers for wheel and rest of the system.
+ */
+  const UINT_t KERNEL_TIMERS = (UINT_t)POSCFG_MAX_TIMER - RESERVED_TIMERS < ENTRIES ?
+                               (UINT_t)POSCFG_MAX_TIMER - RESERVED_TIMERS : ENTRIES;
+
+  static_assert(KERNEL_TIMERS >= 1, "no kernel timers left for native variant");
+
+  pos::Timer timers[KERNEL_TIMERS];
+  bench::Nanos deadlines[KERNEL_TIMERS];
+  pos::Sema fired;
+
+  void kernelTask(void*)
+  {
+    while (pending > 0) {
+
+      fired.get();
+      for (UINT_t i = 0; i < KERNEL_TIMERS; ++i) {
+
+        if (deadlines[i] != 0 && timers[i].fired()) {
+
+          late(deadlines[i]);
+          deadlines[i] = 0;
+          --pending;
+        }
+      }
+    }
+
+    done.signal();
+  }
+
+  void kernelArm()
+  {
+    bench::Nanos start;
+    UINT_t rounds = ROUNDS * ENTRIES / KERNEL_TIMERS;
+
+    start = bench::now();
+    for (UINT_t r = 0; r < rounds; ++r) {
+
+      for (UINT_t i = 0; i < KERNEL_TIMERS; ++i) {
+
+        timers[i].set(fired, HZ + i % SPREAD, 0);
+        timers[i].start();
+      }
+
+      for (UINT_t i = 0; i < KERNEL_TIMERS; ++i)
+        timers[i].stop();
+    }
+
+    bench::report("timerArm", "timer", 2 * rounds * KERNEL_TIMERS,
+                  bench::now() - start, 0, 0);
+
+    for (UINT_t i = 0; i < KERNEL_TIMERS; ++i) {
+
+      timers[i].set(fired, HZ + i % SPREAD, 0);
+      timers[i].start();
+    }
+
+    start = bench::now();
+    for (UINT_t r = 0; r < rounds; ++r) {
+
+      for (UINT_t i = 0; i < KERNEL_TIMERS; ++i) {
+
+        timers[i].stop();
+        timers[i].set(fired, HZ + (i + r) % SPREAD, 0);
+        timers[i].start();
+      }
+    }
+
+    bench::report("timerRearm", "timer", rounds * KERNEL_TIMERS,
+                  bench::now() - start, 0, 0);
+
+    for (UINT_t i = 0; i < KERNEL_TIMERS; ++i)
+      timers[i].stop();
+  }
+
+  void kernelExpiry()
+  {
+    bench::Samples samples(KERNEL_TIMERS);
+    bench::Nanos start;
+
+    lateness = &samples;
+    pending = KERNEL_TIMERS;
+    start = bench::now();
+    for (UINT_t i = 0; i < KERNEL_TIMERS; ++i) {
+
+      deadlines[i] = start + (1 + i % SPREAD) * PERIOD;
+      timers[i].set(fired, 1 + i % SPREAD, 0);
+      timers[i].start();
+    }
+
+    bench::startTask(kernelTask, NULL, bench::PRIO_HIGH, "timers");
+    done.get();
+    bench::report("timerExpiry", "timer", samples);
+  }
+
+  void kernel()
+  {
+    fired.create(0);
+    for (UINT_t i = 0; i < KERNEL_TIMERS; ++i) {
+
+      if (timers[i].create() != 0) {
+
+        printf("timerWheel: cannot create kernel timer %u\n", i);
+        return;
+      }
+    }
+
+    kernelArm();
+    kernelExpiry();
+
+    for (UINT_t i = 0; i < KERNEL_TIMERS; ++i)
+      timers[i].destroy();
+
+#if POSCFG_FEATURE_SEMADESTROY != 0
+    fired.destroy();
+#endif
+  }
+
+#endif
+}
+
+BENCH(timerWheel)
+{
+  done.create(0);
+  if (wheel.create(1) != 0) {
+
+    printf("timerWheel: cannot create wheel\n");
+    return;
+  }
+
+  for (UINT_t i = 0; i < ENTRIES; ++i)
+    timeouts[i].entry.set(expired, &timeouts[i]);
+
+  wheelArm();
+  wheelExpiry();
+
+#if NATIVE_TIMERS
+  kernel();
+#endif
+
+#if POSCFG_FEATURE_TIMERDESTROY != 0 && POSCFG_FEATURE_SEMADESTROY != 0
+  wheel.destroy();
+#endif
+}
+
+#endif
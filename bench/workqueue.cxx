@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Dispatch jobs from a software interrupt handler either to
+ * a task per job kind (each waiting on its own semaphore) or
+ * to pos::WorkQueue with two workers. Reports number of jobs
+ * run, time and number of worker wakeups. With task per job,
+ * every job runs in a task of its own, so wakeups equal jobs.
+ */
+
+#include <stdio.h>
+
+#include "bench.hxx"
+
+#if POSCFG_FEATURE_SOFTINTS != 0
+
+namespace {
+
+  const UINT_t ITEMS = 200000;
+  const UVAR_t BURST = 16;
+  const UVAR_t INTNO = 1;
+  const UINT_t JOBS = 16;
+  const UINT_t WORKERS = 2;
+
+  pos::Sema jobSema[JOBS];
+  pos::WorkQueue queue;
+  pos::WorkQueue::Item items[JOBS];
+  volatile UINT_t produced;
+  pos::AtomicVar<UINT_t> completed;
+  UINT_t coalesced;
+
+  void job(void*)
+  {
+    completed.fetchAdd(1);
+  }
+
+  void jobTask(void* arg)
+  {
+    pos::Sema* sema = static_cast<pos::Sema*>(arg);
+
+    for (;;) {
+
+      sema->get();
+      job(NULL);
+    }
+  }
+
+  void taskHandler(UVAR_t n)
+  {
+    while (n-- > 0 && produced < ITEMS) {
+
+      jobSema[produced % JOBS].signal();
+      produced = produced + 1;
+    }
+  }
+
+  void queueHandler(UVAR_t n)
+  {
+    while (n-- > 0 && produced < ITEMS) {
+
+      if (!queue.submit(items[produced % JOBS]))
+        ++coalesced;
+
+      produced = produced + 1;
+    }
+  }
+
+/*
+ * Handler is installed only once, variants switch
+ * the function it calls.
+ */
+  POSINTFUNC_t current;
+
+  void dispatch(UVAR_t n)
+  {
+    current(n);
+  }
+
+  void run(const char* variant, POSINTFUNC_t handler, unsigned long wakeups)
+  {
+    bench::Nanos start;
+    pos::WorkQueue::Stats before = queue.stats();
+
+    produced = 0;
+    completed.store(0);
+    coalesced = 0;
+    current = handler;
+
+    start = bench::now();
+    while (produced < ITEMS) {
+
+      pos::SoftInt::raise(INTNO, BURST);
+      pos::Task::yield();
+    }
+
+    while (completed.load() < produced - coalesced)
+      pos::Task::sleep(1);
+
+    if (wakeups == 0)
+      wakeups = queue.stats().wakeups - before.wakeups;
+
+    bench::report("workDispatch", variant, completed.load(), bench::now() - start,
+                  0, wakeups);
+  }
+}
+
+BENCH(workDispatch)
+{
+  for (UINT_t i = 0; i < JOBS; ++i) {
+
+    jobSema[i].create(0);
+    bench::startTask(jobTask, &jobSema[i], bench::PRIO_HIGH, "job");
+    items[i].set(job, NULL);
+  }
+
+  queue.create();
+  for (UINT_t i = 0; i < WORKERS; ++i)
+    bench::startTask(pos::WorkQueue::worker, &queue, bench::PRIO_HIGH, "worker");
+
+  pos::SoftInt::setHandler(INTNO, dispatch);
+  run("task-per-job", taskHandler, ITEMS);
+  run("workqueue", queueHandler, 0);
+}
+
+#endif
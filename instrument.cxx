@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <picoos.hxx>
+#include <string.h>
+
+#if OOCFG_FEATURE_INSTRUMENT != 0 && POSCFG_ENABLE_NANO != 0
+
+namespace nos {
+
+  static LockStats table[OOCFG_INSTRUMENT_MAX];
+
+  LockStats* Instrument::attach(const char* name, const char* kind)
+  {
+    POS_LOCKFLAGS;
+    LockStats* stats = NULL;
+
+    POS_SCHED_LOCK;
+    for (UINT_t i = 0; i < OOCFG_INSTRUMENT_MAX; ++i) {
+
+      if (table[i].kind == NULL) {
+
+        stats = &table[i];
+        memset(stats, '\0', sizeof(*stats));
+        stats->name = (name != NULL) ? name : "?";
+        stats->kind = kind;
+        break;
+      }
+    }
+
+    POS_SCHED_UNLOCK;
+    return stats;
+  }
+
+  void Instrument::detach(LockStats* stats)
+  {
+    if (stats != NULL)
+      stats->kind = NULL;
+  }
+
+  void Instrument::reset()
+  {
+    POS_LOCKFLAGS;
+
+    POS_SCHED_LOCK;
+    for (UINT_t i = 0; i < OOCFG_INSTRUMENT_MAX; ++i) {
+
+      LockStats* s = &table[i];
+
+      s->acquires = 0;
+      s->contended = 0;
+      s->totalWait = 0;
+      s->maxWait = 0;
+      s->maxHold = 0;
+    }
+
+    POS_SCHED_UNLOCK;
+  }
+
+  const LockStats* Instrument::get(UINT_t index)
+  {
+    if (index >= OOCFG_INSTRUMENT_MAX || table[index].kind == NULL)
+      return NULL;
+
+    return &table[index];
+  }
+
+#if NOSCFG_FEATURE_CONOUT != 0 && NOSCFG_FEATURE_PRINTF != 0 && NOSCFG_FEATURE_USE_STDARG != 0
+
+/*
+ * Print objects in order of total wait time, longest first.
+ * Statistics are copied so that they are consistent while printing.
+ */
+  void Instrument::report(UINT_t count)
+  {
+    UVAR_t printed[OOCFG_INSTRUMENT_MAX];
+    LockStats s;
+
+    memset(printed, '\0', sizeof(printed));
+    Console::printf("name kind acquires contended wait-total wait-max hold-max owner\n");
+
+    while (count-- > 0) {
+
+      POS_LOCKFLAGS;
+      INT_t best = -1;
+
+      POS_SCHED_LOCK;
+      for (UINT_t i = 0; i < OOCFG_INSTRUMENT_MAX; ++i) {
+
+        if (table[i].kind == NULL || printed[i])
+          continue;
+
+        if (best == -1 ||
+            table[i].totalWait > table[best].totalWait ||
+            (table[i].totalWait == table[best].totalWait &&
+             table[i].contended > table[best].contended))
+          best = i;
+      }
+
+      if (best != -1)
+        s = table[best];
+
+      POS_SCHED_UNLOCK;
+
+      if (best == -1)
+        break;
+
+      printed[best] = 1;
+      Console::printf("%s %s %u %u %u %u %u %x\n",
+                      s.name, s.kind, s.acquires, s.contended,
+                      s.totalWait, s.maxWait, s.maxHold,
+                      (UINT_t)(size_t)s.owner);
+    }
+  }
+
+#endif
+}
+
+#endif
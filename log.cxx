@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <picoos.hxx>
+
+#if NOSCFG_FEATURE_CONOUT != 0 && POSCFG_FEATURE_SEMAPHORES != 0
+
+namespace {
+
+  void pad(UINT_t n, char fill)
+  {
+    while (n-- > 0)
+      nosPrintChar(fill);
+  }
+
+/*
+ * Print field padded to width.
+ */
+  void field(const char* s, UINT_t len, UINT_t width, bool left, char fill)
+  {
+    UINT_t n = (len < width) ? width - len : 0;
+
+    if (!left)
+      pad(n, fill);
+
+    while (len-- > 0)
+      nosPrintChar(*s++);
+
+    if (left)
+      pad(n, ' ');
+  }
+
+  void number(unsigned long v, UINT_t base, bool upper, bool neg,
+              UINT_t width, bool left, bool zero)
+  {
+    const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buf[sizeof(unsigned long) * 3 + 1];
+    char* p = buf + sizeof(buf);
+
+    do {
+
+      *--p = digits[v % base];
+      v /= base;
+    } while (v != 0);
+
+    if (neg) {
+
+      if (zero && !left) {
+
+        nosPrintChar('-');
+        if (width > 0)
+          --width;
+      }
+      else
+        *--p = '-';
+    }
+
+    field(p, buf + sizeof(buf) - p, width, left, (zero && !left) ? '0' : ' ');
+  }
+
+  void pointer(const void* ptr)
+  {
+    size_t v = (size_t)ptr;
+
+    nosPrintChar('0');
+    nosPrintChar('x');
+    for (int shift = sizeof(size_t) * 8 - 4; shift >= 0; shift -= 4)
+      nosPrintChar("0123456789abcdef"[(v >> shift) & 0xf]);
+  }
+}
+
+namespace nos {
+
+  Log::Log()
+  {
+    for (UINT_t i = 0; i < SIZE; ++i)
+      records[i].seq = i;
+
+    head = 0;
+    tail = 0;
+    drops = 0;
+    reported = 0;
+    running = false;
+  }
+
+  VAR_t Log::create()
+  {
+    if (ready.create(0) != 0)
+      return -1;
+
+    running = true;
+    return 0;
+  }
+
+#if NOSCFG_FEATURE_TASKCREATE != 0
+
+  VAR_t Log::start(VAR_t priority, UINT_t stacksize)
+  {
+    nos::Task drain;
+
+    if (create() != 0)
+      return -1;
+
+    return drain.create(task, this, priority, stacksize, "log");
+  }
+
+#endif
+
+/*
+ * Records form a bounded queue where each record has a sequence
+ * number. Record at position pos is free when its sequence is pos,
+ * and contains data when sequence is pos + 1. After printing,
+ * sequence is advanced by buffer size for next round.
+ */
+  Log::Record* Log::reserve(UINT_t& pos)
+  {
+#if OOCFG_LOG_LOCKFREE != 0
+
+    pos = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    for (;;) {
+
+      Record* r = &records[pos & (SIZE - 1)];
+      INT_t diff = (INT_t)(__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) - pos);
+
+      if (diff == 0) {
+
+        if (__atomic_compare_exchange_n(&head, &pos, pos + 1, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+          return r;
+      }
+      else if (diff < 0) {
+
+        __atomic_fetch_add(&drops, 1, __ATOMIC_RELAXED);
+        return NULL;
+      }
+      else
+        pos = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    }
+
+#else
+
+    POS_LOCKFLAGS;
+    Record* r;
+
+    POS_SCHED_LOCK;
+    pos = head;
+    r = &records[pos & (SIZE - 1)];
+    if (__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) != pos) {
+
+      ++drops;
+      r = NULL;
+    }
+    else
+      head = pos + 1;
+
+    POS_SCHED_UNLOCK;
+    return r;
+
+#endif
+  }
+
+/*
+ * Make record visible to drain task. Drain task is woken up
+ * only when buffer becomes half full, otherwise records are
+ * printed at next periodic flush.
+ */
+  void Log::publish(UINT_t pos)
+  {
+    __atomic_store_n(&records[pos & (SIZE - 1)].seq, pos + 1, __ATOMIC_RELEASE);
+    if (running && pos + 1 - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) == SIZE / 2)
+      ready.signal();
+  }
+
+  void Log::flush()
+  {
+    if (running)
+      ready.signal();
+  }
+
+  void Log::print(const Record* r)
+  {
+    const char* f = r->fmt;
+    UINT_t a = 0;
+
+    while (*f != '\0') {
+
+      if (*f != '%') {
+
+        nosPrintChar(*f++);
+        continue;
+      }
+
+      ++f;
+      if (*f == '%') {
+
+        nosPrintChar(*f++);
+        continue;
+      }
+
+      bool left = false;
+      bool zero = false;
+      UINT_t width = 0;
+
+      for (; *f == '-' || *f == '0'; ++f) {
+
+        if (*f == '-')
+          left = true;
+        else
+          zero = true;
+      }
+
+      for (; *f >= '0' && *f <= '9'; ++f)
+        width = width * 10 + (*f - '0');
+
+      bool wide = false;
+
+      if (*f == 'l') {
+
+        wide = true;
+        ++f;
+      }
+
+      if (*f == '\0')
+        break;
+
+      if (a >= r->count) {
+
+        nosPrintChar('?');
+        ++f;
+        continue;
+      }
+
+      const LogArg& arg = r->args[a++];
+      char c;
+
+      switch (*f++) {
+      case 'd':
+      case 'i':
+        {
+          long v = wide ? arg.li : arg.i;
+
+          if (v < 0)
+            number(0UL - (unsigned long)v, 10, false, true, width, left, zero);
+          else
+            number((unsigned long)v, 10, false, false, width, left, zero);
+        }
+        break;
+
+      case 'u':
+        number(wide ? arg.lu : arg.u, 10, false, false, width, left, zero);
+        break;
+
+      case 'x':
+        number(wide ? arg.lu : arg.u, 16, false, false, width, left, zero);
+        break;
+
+      case 'X':
+        number(wide ? arg.lu : arg.u, 16, true, false, width, left, zero);
+        break;
+
+      case 'c':
+        c = (char)arg.i;
+        field(&c, 1, width, left, ' ');
+        break;
+
+      case 's':
+        {
+          const char* s = (arg.s != NULL) ? arg.s : "(null)";
+          const char* e = s;
+
+          while (*e != '\0')
+            ++e;
+
+          field(s, e - s, width, left, ' ');
+        }
+        break;
+
+      case 'p':
+        pointer(arg.p);
+        break;
+
+      default:
+        nosPrintChar('?');
+        break;
+      }
+    }
+  }
+
+  UINT_t Log::process()
+  {
+    UINT_t count = 0;
+    UINT_t d;
+
+    for (;;) {
+
+      Record* r = &records[tail & (SIZE - 1)];
+
+      if (__atomic_load_n(&r->seq, __ATOMIC_ACQUIRE) != tail + 1)
+        break;
+
+      print(r);
+      __atomic_store_n(&r->seq, tail + SIZE, __ATOMIC_RELEASE);
+      __atomic_store_n(&tail, tail + 1, __ATOMIC_RELEASE);
+      ++count;
+    }
+
+    d = dropped();
+    if (d != reported) {
+
+      Record note;
+
+      note.fmt = "*** %u log records dropped\n";
+      note.count = 1;
+      note.args[0].u = d - reported;
+      print(&note);
+      reported = d;
+    }
+
+    return count;
+  }
+
+  void Log::task(void* arg)
+  {
+    Log* log = static_cast<Log*>(arg);
+
+    for (;;) {
+
+#if POSCFG_FEATURE_SEMAWAIT != 0
+      log->ready.wait(OOCFG_LOG_FLUSH_TICKS);
+#else
+      log->ready.get();
+#endif
+      log->process();
+    }
+  }
+}
+
+#endif
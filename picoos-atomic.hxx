@@ -44,6 +44,21 @@ extern "C" {
 
 }
 
+/**
+ * Use compiler's native atomic operations in ::pos::AtomicVar.
+ * Defaults to 1 if compiler has lock-free atomic operations for
+ * the target. When 0, or when type is too large for native
+ * operations, scheduler lock is used like in ::posAtomicAdd and
+ * other kernel functions.
+ */
+#ifndef OOCFG_ATOMIC_NATIVE
+#if defined(__GCC_ATOMIC_INT_LOCK_FREE) && __GCC_ATOMIC_INT_LOCK_FREE == 2
+#define OOCFG_ATOMIC_NATIVE 1
+#else
+#define OOCFG_ATOMIC_NATIVE 0
+#endif
+#endif
+
 namespace pos {
 
 #if (DOX!=0) || (POSCFG_FEATURE_ATOMICVAR != 0)
@@ -151,6 +166,368 @@ namespace pos {
 
 #endif /* POSCFG_FEATURE_ATOMICVAR */
 
+/**
+ * Memory ordering for ::pos::AtomicVar operations. Values have
+ * same meaning as in C++11 std::memory_order. When scheduler lock
+ * is used instead of native atomics, all operations act as
+ * ::pos::MemorySeqCst.
+ */
+  enum MemoryOrder
+  {
+    MemoryRelaxed = __ATOMIC_RELAXED,
+    MemoryAcquire = __ATOMIC_ACQUIRE,
+    MemoryRelease = __ATOMIC_RELEASE,
+    MemoryAcqRel  = __ATOMIC_ACQ_REL,
+    MemorySeqCst  = __ATOMIC_SEQ_CST
+  };
+
+/*
+ * Tells if type is a pointer. Arithmetic and bitwise
+ * operations of AtomicVar are not available for pointers.
+ */
+  template<typename T>
+  struct AtomicPointer
+  {
+    static const bool value = false;
+  };
+
+  template<typename T>
+  struct AtomicPointer<T*>
+  {
+    static const bool value = true;
+  };
+
+/*
+ * Implementation of AtomicVar operations, either with native
+ * atomics or with scheduler lock.
+ */
+  template<typename T, bool Native>
+  struct AtomicOps
+  {
+    static inline T load(const T* v, MemoryOrder o)
+    {
+      return __atomic_load_n(v, o);
+    }
+
+    static inline void store(T* v, T x, MemoryOrder o)
+    {
+      __atomic_store_n(v, x, o);
+    }
+
+    static inline T exchange(T* v, T x, MemoryOrder o)
+    {
+      return __atomic_exchange_n(v, x, o);
+    }
+
+    static inline bool compareExchange(T* v, T& expected, T desired, bool weak,
+                                       MemoryOrder success, MemoryOrder failure)
+    {
+      return __atomic_compare_exchange_n(v, &expected, desired, weak, success, failure);
+    }
+
+    static inline T fetchAdd(T* v, T x, MemoryOrder o)
+    {
+      return __atomic_fetch_add(v, x, o);
+    }
+
+    static inline T fetchSub(T* v, T x, MemoryOrder o)
+    {
+      return __atomic_fetch_sub(v, x, o);
+    }
+
+    static inline T fetchOr(T* v, T x, MemoryOrder o)
+    {
+      return __atomic_fetch_or(v, x, o);
+    }
+
+    static inline T fetchAnd(T* v, T x, MemoryOrder o)
+    {
+      return __atomic_fetch_and(v, x, o);
+    }
+
+    static inline T fetchXor(T* v, T x, MemoryOrder o)
+    {
+      return __atomic_fetch_xor(v, x, o);
+    }
+  };
+
+  template<typename T>
+  struct AtomicOps<T, false>
+  {
+    static inline T load(const T* v, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      T x;
+
+      POS_SCHED_LOCK;
+      x = *v;
+      POS_SCHED_UNLOCK;
+      return x;
+    }
+
+    static inline void store(T* v, T x, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+
+      POS_SCHED_LOCK;
+      *v = x;
+      POS_SCHED_UNLOCK;
+    }
+
+    static inline T exchange(T* v, T x, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      T old;
+
+      POS_SCHED_LOCK;
+      old = *v;
+      *v = x;
+      POS_SCHED_UNLOCK;
+      return old;
+    }
+
+    static inline bool compareExchange(T* v, T& expected, T desired, bool,
+                                       MemoryOrder, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      bool ok;
+
+      POS_SCHED_LOCK;
+      ok = (*v == expected);
+      if (ok)
+        *v = desired;
+      else
+        expected = *v;
+
+      POS_SCHED_UNLOCK;
+      return ok;
+    }
+
+    static inline T fetchAdd(T* v, T x, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      T old;
+
+      POS_SCHED_LOCK;
+      old = *v;
+      *v = old + x;
+      POS_SCHED_UNLOCK;
+      return old;
+    }
+
+    static inline T fetchSub(T* v, T x, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      T old;
+
+      POS_SCHED_LOCK;
+      old = *v;
+      *v = old - x;
+      POS_SCHED_UNLOCK;
+      return old;
+    }
+
+    static inline T fetchOr(T* v, T x, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      T old;
+
+      POS_SCHED_LOCK;
+      old = *v;
+      *v = old | x;
+      POS_SCHED_UNLOCK;
+      return old;
+    }
+
+    static inline T fetchAnd(T* v, T x, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      T old;
+
+      POS_SCHED_LOCK;
+      old = *v;
+      *v = old & x;
+      POS_SCHED_UNLOCK;
+      return old;
+    }
+
+    static inline T fetchXor(T* v, T x, MemoryOrder)
+    {
+      POS_LOCKFLAGS;
+      T old;
+
+      POS_SCHED_LOCK;
+      old = *v;
+      *v = old ^ x;
+      POS_SCHED_UNLOCK;
+      return old;
+    }
+  };
+
+/**
+ * Atomic variable of any integer or pointer type. Unlike ::pos::Atomic,
+ * which always calls kernel functions, operations are compiled
+ * to native atomic instructions when the port supports them
+ * (see ::OOCFG_ATOMIC_NATIVE). Otherwise scheduler is locked
+ * for duration of the operation, like kernel does.
+ * In addition to arithmetic, compare-and-swap, exchange and
+ * bitwise operations are supported, with memory ordering parameters.
+ * For pointer types only load, store, exchange and compare-and-swap
+ * are available.
+ * Operations can be used from tasks and software interrupt handlers.
+ * @code
+ * static pos::AtomicVar<UVAR_t> events;
+ *
+ * events.fetchOr(EV_RX);                  // producer
+ * UVAR_t ev = events.exchange(0);         // consumer
+ * @endcode
+ * @note    Named AtomicVar because ::pos::Atomic is already used for
+ *          the kernel atomic variable wrapper.
+ */
+  template<typename T>
+  class AtomicVar
+  {
+  private:
+    typedef AtomicOps<T, OOCFG_ATOMIC_NATIVE != 0 && __atomic_always_lock_free(sizeof(T), 0)> Ops;
+
+  public:
+
+/* 
+ * Constructors.
+ */
+    inline AtomicVar() : var()
+    {
+    }
+
+    inline AtomicVar(T value) : var(value)
+    {
+    }
+
+/**
+ * Returns true if native atomic operations are used for this type.
+ */
+    static inline bool isLockFree()
+    {
+      return OOCFG_ATOMIC_NATIVE != 0 && __atomic_always_lock_free(sizeof(T), 0);
+    }
+
+/**
+ * Returns current value.
+ * @param   order  memory ordering.
+ * @sa      store
+ */
+    inline T load(MemoryOrder order = MemorySeqCst) const
+    {
+      return Ops::load(&var, order);
+    }
+
+/**
+ * Sets new value.
+ * @param   value  new value.
+ * @param   order  memory ordering.
+ * @sa      load
+ */
+    inline void store(T value, MemoryOrder order = MemorySeqCst)
+    {
+      Ops::store(&var, value, order);
+    }
+
+/**
+ * Sets new value and returns previous one.
+ * @param   value  new value.
+ * @param   order  memory ordering.
+ * @return  value before exchange.
+ */
+    inline T exchange(T value, MemoryOrder order = MemorySeqCst)
+    {
+      return Ops::exchange(&var, value, order);
+    }
+
+/**
+ * Compare-and-swap. If current value equals expected, it is replaced
+ * with desired value. Otherwise, current value is stored to expected.
+ * @param   expected  value that variable is expected to have.
+ * @param   desired   new value.
+ * @param   success   memory ordering if exchange was done.
+ * @param   failure   memory ordering if exchange was not done.
+ * @return  true if exchange was done.
+ * @sa      compareExchangeWeak
+ */
+    inline bool compareExchange(T& expected, T desired,
+                                MemoryOrder success = MemorySeqCst,
+                                MemoryOrder failure = MemorySeqCst)
+    {
+      return Ops::compareExchange(&var, expected, desired, false, success, failure);
+    }
+
+/**
+ * Like compareExchange, but is allowed to fail spuriously.
+ * Can be faster on some processors when used in a loop.
+ * @sa      compareExchange
+ */
+    inline bool compareExchangeWeak(T& expected, T desired,
+                                    MemoryOrder success = MemorySeqCst,
+                                    MemoryOrder failure = MemorySeqCst)
+    {
+      return Ops::compareExchange(&var, expected, desired, true, success, failure);
+    }
+
+/**
+ * Adds a value.
+ * @return  value before addition.
+ */
+    inline T fetchAdd(T value, MemoryOrder order = MemorySeqCst)
+    {
+      static_assert(!AtomicPointer<T>::value, "fetchAdd needs integer type");
+      return Ops::fetchAdd(&var, value, order);
+    }
+
+/**
+ * Substracts a value.
+ * @return  value before substraction.
+ */
+    inline T fetchSub(T value, MemoryOrder order = MemorySeqCst)
+    {
+      static_assert(!AtomicPointer<T>::value, "fetchSub needs integer type");
+      return Ops::fetchSub(&var, value, order);
+    }
+
+/**
+ * Sets bits.
+ * @return  value before operation.
+ */
+    inline T fetchOr(T value, MemoryOrder order = MemorySeqCst)
+    {
+      static_assert(!AtomicPointer<T>::value, "fetchOr needs integer type");
+      return Ops::fetchOr(&var, value, order);
+    }
+
+/**
+ * Clears bits that are not set in value.
+ * @return  value before operation.
+ */
+    inline T fetchAnd(T value, MemoryOrder order = MemorySeqCst)
+    {
+      static_assert(!AtomicPointer<T>::value, "fetchAnd needs integer type");
+      return Ops::fetchAnd(&var, value, order);
+    }
+
+/**
+ * Toggles bits.
+ * @return  value before operation.
+ */
+    inline T fetchXor(T value, MemoryOrder order = MemorySeqCst)
+    {
+      static_assert(!AtomicPointer<T>::value, "fetchXor needs integer type");
+      return Ops::fetchXor(&var, value, order);
+    }
+
+  private:
+    T var;
+
+    AtomicVar(const AtomicVar&);
+    AtomicVar& operator=(const AtomicVar&);
+  };
 }
 
 #endif /* _PICOOS_ATOMIC_HXX */
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-channel.hxx
+ * @brief   Pico]OS oo-wrapper Channel
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_CHANNEL_HXX
+#define _PICOOS_CHANNEL_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+#if (DOX!=0) || (POSCFG_FEATURE_SEMAPHORES != 0)
+
+namespace pos {
+
+/**
+ * Channel is a typed message queue with its own, statically sized
+ * message pool. Unlike ::pos::Message, which passes untyped buffers
+ * through the single global message pool, each channel
+ * owns Depth slots for messages of type T. Messages are constructed
+ * directly in the slot (::pos::Channel::construct), the slot pointer
+ * is queued (::pos::Channel::send) and the receiver gets the same
+ * pointer back (::pos::Channel::receive). No message data is copied.
+ * The receiver owns the message until it is returned to the pool with
+ * ::pos::Channel::free.@n
+ * @n
+ * Several messages can be queued and received with a single
+ * operation (::pos::Channel::sendN and ::pos::Channel::receiveN).
+ * The receiving task is woken up only when the channel goes from
+ * empty to non-empty, so a producer sending a burst of messages
+ * causes only one wakeup of the receiver, which can then drain
+ * the whole burst.@n
+ * @n
+ * A channel can have any number of sending tasks, but only one
+ * receiving task (in the same way as a message box belongs to
+ * a single task). Allocating, sending and freeing messages is
+ * also allowed from software interrupt handlers.
+ * @code
+ * struct Sample { UINT_t channel; INT_t value; };
+ * static pos::Channel<Sample, 16> samples;
+ *
+ * // producer
+ * Sample* s = samples.construct();
+ * s->channel = 1;
+ * s->value = adcValue;
+ * samples.send(s);
+ *
+ * // consumer
+ * Sample* batch[8];
+ * UINT_t n = samples.receiveN(batch, 8, INFINITE);
+ * for (UINT_t i = 0; i < n; ++i) {
+ *
+ *   process(batch[i]);
+ *   samples.free(batch[i]);
+ * }
+ * @endcode
+ */
+  template<class T, UINT_t Depth>
+  class Channel
+  {
+  public:
+
+/* 
+ * Constructors.
+ */
+    inline Channel()
+    {
+      head = 0;
+      count = 0;
+      waiting = 0;
+    };
+
+/**
+ * Creates the semaphore used to wake up the receiving task.
+ * Must be called before the channel is used.
+ * @return  channel creation status. -1 is returned when the
+ *          semaphore could not be created.
+ * @note    ::POSCFG_FEATURE_SEMAPHORES must be defined to 1 
+ *          to have channel support compiled in.
+ * @sa      destroy, construct, send, receive
+ */
+    inline VAR_t create()
+    {
+      return ready.create(0);
+    }
+
+#if (DOX!=0) || (POSCFG_FEATURE_SEMADESTROY != 0)
+/**
+ * Frees the semaphore of channel. Messages still in the
+ * channel are not destructed.
+ * @note    ::POSCFG_FEATURE_SEMADESTROY must be defined to 1
+ *          to have this function compiled in.
+ * @sa      create
+ */
+    inline void destroy()
+    {
+      ready.destroy();
+    }
+#endif
+
+/**
+ * Allocates a message slot from channel pool and constructs
+ * a message of type T into it using given constructor arguments.
+ * @return  pointer to the new message. NULL is returned
+ *          if all slots are in use.
+ * @sa      send, free
+ */
+    template<typename... Args>
+    inline T* construct(Args&&... args)
+    {
+      return pool.construct(static_cast<Args&&>(args)...);
+    }
+
+/**
+ * Destructs a message and returns its slot back to
+ * channel pool. Usually the receiving task would call
+ * this after it has processed the message.
+ * @param   msg  message received from channel.
+ * @sa      construct, receive
+ */
+    inline void free(T* msg)
+    {
+      pool.destroy(msg);
+    }
+
+/**
+ * Queues a message to channel. Ownership of message is transferred
+ * to the receiving task.
+ * @param   msg  message allocated with ::pos::Channel::construct.
+ * @return  zero on success.
+ * @sa      sendN, construct, receive
+ */
+    inline VAR_t send(T* msg)
+    {
+      return sendN(&msg, 1);
+    }
+
+/**
+ * Queues several messages to channel. The receiving
+ * task is woken up at most once.
+ * @param   msgs  array of messages allocated with ::pos::Channel::construct.
+ * @param   n     number of messages in array.
+ * @return  zero on success.
+ * @sa      send, construct, receiveN
+ */
+    VAR_t sendN(T* const* msgs, UINT_t n)
+    {
+      POS_LOCKFLAGS;
+      UVAR_t wakeup;
+
+      POS_SCHED_LOCK;
+      for (UINT_t i = 0; i < n; ++i) {
+
+        UINT_t tail = head + count;
+
+        if (tail >= Depth)
+          tail -= Depth;
+
+        queue[tail] = msgs[i];
+        ++count;
+      }
+
+      wakeup = (n > 0 && waiting);
+      if (wakeup)
+        waiting = 0;
+
+      POS_SCHED_UNLOCK;
+
+      if (wakeup)
+        return ready.signal();
+
+      return 0;
+    }
+
+/**
+ * Gets a message from channel.
+ * If no message is available, the task blocks until a new message
+ * is sent.
+ * @return  pointer to the received message. Message must be freed
+ *          with ::pos::Channel::free after processing.
+ *          NULL is returned on error.
+ * @sa      receiveN, tryReceive, free
+ */
+    inline T* receive()
+    {
+      T* msg = NULL;
+
+      receiveN(&msg, 1, INFINITE);
+      return msg;
+    }
+
+/**
+ * Gets a message from channel without blocking.
+ * @return  pointer to the received message. NULL is returned
+ *          if channel is empty.
+ * @sa      receive, receiveN, free
+ */
+    inline T* tryReceive()
+    {
+      T* msg;
+
+      if (take(&msg, 1, 0) == 0)
+        return NULL;
+
+      return msg;
+    }
+
+/**
+ * Gets all queued messages, up to given maximum, from channel.
+ * If no message is available, the task blocks until a message
+ * is sent or the timeout has been reached. All messages that were
+ * sent while the task was waiting are returned at once.
+ * @param   msgs  array to store received messages.
+ * @param   max   size of message array.
+ * @param   timeoutticks  timeout in timer ticks
+ *          (see ::HZ define and ::MS macro).
+ *          If this parameter is set to zero, the function immediately
+ *          returns. If this parameter is set to INFINITE, the
+ *          function will never time out.
+ * @return  number of messages stored into array. Zero is returned
+ *          when no message was received within the specified time.
+ * @note    ::POSCFG_FEATURE_SEMAWAIT must be defined to 1
+ *          to use timeouts other than INFINITE. Without
+ *          ::POSCFG_FEATURE_JIFFIES the full timeout is
+ *          restarted after a wakeup that returned no messages.
+ * @sa      receive, sendN, free
+ */
+    UINT_t receiveN(T** msgs, UINT_t max, UINT_t timeoutticks)
+    {
+      UINT_t n;
+      VAR_t status;
+#if POSCFG_FEATURE_SEMAWAIT != 0 && POSCFG_FEATURE_JIFFIES != 0
+      JIF_t deadline = jiffies + timeoutticks;
+#endif
+
+      for (;;) {
+
+        n = take(msgs, max, timeoutticks != 0);
+        if (n > 0 || timeoutticks == 0)
+          return n;
+
+#if POSCFG_FEATURE_SEMAWAIT != 0
+        if (timeoutticks != INFINITE) {
+
+#if POSCFG_FEATURE_JIFFIES != 0
+          JIF_t now = jiffies;
+
+          status = POS_TIMEAFTER(deadline, now) ? ready.wait((UINT_t)(deadline - now)) : 1;
+#else
+          status = ready.wait(timeoutticks);
+#endif
+        }
+        else
+#endif
+          status = ready.get();
+
+        if (status != 0) {
+
+/*
+ * Timeout. Cancel the wakeup request and return any message
+ * that might have arrived after it.
+ */
+          POS_LOCKFLAGS;
+
+          POS_SCHED_LOCK;
+          waiting = 0;
+          POS_SCHED_UNLOCK;
+
+          return take(msgs, max, 0);
+        }
+      }
+    }
+
+/**
+ * Returns number of messages that are queued in channel.
+ */
+    inline UINT_t available() const
+    {
+      return count;
+    }
+
+/**
+ * Returns the maximum number of message slots that have been
+ * in use at the same time.
+ */
+    inline UINT_t highWater() const
+    {
+      return pool.highWater();
+    }
+
+  private:
+/*
+ * Dequeue messages. If channel is empty and wakeup is requested,
+ * register receiver as waiting so that next send signals it.
+ */
+    UINT_t take(T** msgs, UINT_t max, UVAR_t wakeup)
+    {
+      POS_LOCKFLAGS;
+      UINT_t n = 0;
+
+      POS_SCHED_LOCK;
+      while (n < max && count > 0) {
+
+        msgs[n++] = queue[head];
+        if (++head == Depth)
+          head = 0;
+
+        --count;
+      }
+
+      if (n == 0 && wakeup)
+        waiting = 1;
+
+      POS_SCHED_UNLOCK;
+      return n;
+    }
+
+    Pool<T, Depth> pool;
+    T* queue[Depth];
+    UINT_t head;
+    UINT_t count;
+    UVAR_t waiting;
+    Sema ready;
+
+    Channel(const Channel&);
+    Channel& operator=(const Channel&);
+  };
+}
+
+#endif /* POSCFG_FEATURE_SEMAPHORES */
+#endif /* _PICOOS_CHANNEL_HXX */
@@ -0,0 +1,903 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-coroutine.hxx
+ * @brief   Pico]OS oo-wrapper coroutine Executor
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_COROUTINE_HXX
+#define _PICOOS_COROUTINE_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+/**
+ * Number of coroutine frames in the frame pool used
+ * by ::pos::CoTask. Can be defined in noscfg.h.
+ */
+#ifndef OOCFG_CORO_FRAMES
+#define OOCFG_CORO_FRAMES 16
+#endif
+
+/**
+ * Size of one coroutine frame in bytes. Coroutines whose
+ * frame is larger than this cannot be created.
+ */
+#ifndef OOCFG_CORO_FRAME_SIZE
+#define OOCFG_CORO_FRAME_SIZE 256
+#endif
+
+/**
+ * Maximum interval in timer ticks between polls of kernel
+ * objects that coroutines wait for. Interval starts at one tick
+ * and doubles while polled objects do not become ready.
+ * Must be at least 1.
+ */
+#ifndef OOCFG_CORO_POLL_MAX
+#define OOCFG_CORO_POLL_MAX MS(100)
+#endif
+
+#if DOX!=0 || (defined(__cpp_impl_coroutine) && POSCFG_FEATURE_SEMAPHORES != 0 && POSCFG_FEATURE_SEMAWAIT != 0 && POSCFG_FEATURE_JIFFIES != 0)
+
+#include <stddef.h>
+#include <coroutine>
+#include <exception>
+
+namespace pos {
+
+  class Executor;
+
+/**
+ * Fixed pool for coroutine frames. Frames are never allocated
+ * from heap. Pool size is set by ::OOCFG_CORO_FRAMES and
+ * ::OOCFG_CORO_FRAME_SIZE.
+ */
+  class CoFrames
+  {
+  public:
+
+/**
+ * Allocates a frame.
+ * @param   size  size of coroutine frame, as requested by compiler.
+ * @return  pointer to frame or NULL if pool is empty or frame
+ *          is too large.
+ */
+    static inline void* alloc(size_t size) noexcept
+    {
+      if (size > sizeof(Frame))
+        return NULL;
+
+      if (size > maxSize)
+        maxSize = size;
+
+      return pool.alloc();
+    }
+
+/**
+ * Returns frame to pool.
+ */
+    static inline void free(void* frame) noexcept
+    {
+      pool.free(static_cast<Frame*>(frame));
+    }
+
+/**
+ * Returns number of frames in use.
+ */
+    static inline UINT_t used()
+    {
+      return pool.used();
+    }
+
+/**
+ * Returns maximum number of frames that have been in use.
+ */
+    static inline UINT_t highWater()
+    {
+      return pool.highWater();
+    }
+
+/**
+ * Returns size of largest frame requested so far. Useful
+ * for tuning ::OOCFG_CORO_FRAME_SIZE.
+ */
+    static inline UINT_t largest()
+    {
+      return maxSize;
+    }
+
+/**
+ * Returns size of frame slot in pool.
+ */
+    static inline UINT_t slotSize()
+    {
+      return sizeof(Frame);
+    }
+
+  private:
+    struct Frame
+    {
+      alignas(max_align_t) unsigned char data[OOCFG_CORO_FRAME_SIZE];
+    };
+
+    static inline Pool<Frame, OOCFG_CORO_FRAMES> pool;
+    static inline UINT_t maxSize = 0;
+  };
+
+/**
+ * Coroutine activity run by ::pos::Executor. Any function
+ * that returns CoTask and uses co_await is a coroutine.
+ * Calling it creates the coroutine frame (from ::pos::CoFrames)
+ * but does not start it, coroutine starts when it is
+ * given to ::pos::Executor::spawn.
+ * @code
+ * pos::CoTask blink(pos::Sema& button)
+ * {
+ *   for (;;) {
+ *
+ *     if (co_await pos::AwaitSema(button, MS(500)) == 0)
+ *       toggleLed();
+ *   }
+ * }
+ * @endcode
+ */
+  class CoTask
+  {
+  public:
+    struct promise_type
+    {
+      Executor* executor;
+      promise_type* next;
+
+      static inline void* operator new(size_t size) noexcept
+      {
+        return CoFrames::alloc(size);
+      }
+
+      static inline void operator delete(void* frame) noexcept
+      {
+        CoFrames::free(frame);
+      }
+
+      static inline CoTask get_return_object_on_allocation_failure() noexcept
+      {
+        return CoTask();
+      }
+
+      inline CoTask get_return_object() noexcept
+      {
+        return CoTask(std::coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      inline std::suspend_always initial_suspend() noexcept
+      {
+        return std::suspend_always();
+      }
+
+      inline std::suspend_always final_suspend() noexcept
+      {
+        return std::suspend_always();
+      }
+
+      inline void return_void() noexcept
+      {
+      }
+
+      inline void unhandled_exception() noexcept
+      {
+        std::terminate();
+      }
+    };
+
+    typedef std::coroutine_handle<promise_type> Handle;
+
+/* 
+ * Constructors.
+ */
+    inline CoTask() : handle()
+    {
+    }
+
+    inline CoTask(CoTask&& other) : handle(other.handle)
+    {
+      other.handle = Handle();
+    }
+
+    inline ~CoTask()
+    {
+      if (handle)
+        handle.destroy();
+    }
+
+    inline CoTask& operator=(CoTask&& other)
+    {
+      if (handle)
+        handle.destroy();
+
+      handle = other.handle;
+      other.handle = Handle();
+      return *this;
+    }
+
+/**
+ * Returns false if coroutine frame could not be allocated.
+ */
+    inline bool valid() const
+    {
+      return (bool)handle;
+    }
+
+  private:
+    friend class Executor;
+
+    inline explicit CoTask(Handle h) : handle(h)
+    {
+    }
+
+    CoTask(const CoTask&);
+    CoTask& operator=(const CoTask&);
+
+    Handle handle;
+  };
+
+/**
+ * Coroutine executor runs many stackless coroutines (::pos::CoTask)
+ * inside one ::pos::Task. A coroutine needs only a small frame
+ * from ::pos::CoFrames instead of a full task stack, so much more
+ * concurrent activities fit into same RAM.@n
+ * @n
+ * Coroutines wait by co_await on awaitables: ::pos::AwaitSema,
+ * ::pos::AwaitFlag, ::pos::AwaitMessage, ::pos::AwaitTimer,
+ * ::pos::AwaitSleep, ::pos::AwaitDeadline, ::pos::AwaitYield and
+ * ::pos::CoSema. Blocking code can be ported by replacing
+ * calls like sema.wait(timeout) with co_await pos::AwaitSema(sema, timeout).@n
+ * @n
+ * Kernel does not know about coroutines, so executor polls kernel
+ * objects that coroutines are waiting for. Polling starts at every
+ * timer tick when a coroutine starts to wait, and interval doubles
+ * up to ::OOCFG_CORO_POLL_MAX ticks while nothing becomes ready,
+ * so a coroutine that waits for a long time does not wake up executor
+ * task at every tick. Task that signals a kernel object should call
+ * ::pos::Executor::notify to get waiting coroutine run immediately.
+ * Deadlines and ::pos::CoSema do not need polling.
+ * @code
+ * static pos::Executor executor;
+ * static pos::Task executorTask;
+ *
+ * executor.create();
+ * executor.spawn(blink(button1));
+ * executor.spawn(blink(button2));
+ * executorTask.create(pos::Executor::task, &executor, 2, 1024);
+ * @endcode
+ * @note    Messages are sent to a task, so all coroutines of
+ *          one executor share the mailbox of executor task.
+ */
+  class Executor
+  {
+  public:
+    typedef CoTask::promise_type Promise;
+
+/*
+ * Base for awaitables that wait for kernel objects or deadlines.
+ */
+    struct Waiter
+    {
+      Waiter* next;
+      Promise* promise;
+      bool (*check)(Waiter* w);
+      JIF_t deadline;
+      bool timed;
+      bool expired;
+    };
+
+/* 
+ * Constructors.
+ */
+    inline Executor() : readyHead(NULL), readyTail(NULL), waiters(NULL),
+                        live(0), nextWait(0), pollInterval(1), pollStamp(0)
+    {
+    }
+
+/**
+ * Creates semaphore used to wake up executor.
+ * @return  zero on success, -1 on failure.
+ */
+    inline VAR_t create()
+    {
+      return wake.create(0);
+    }
+
+/**
+ * Starts a coroutine. Can be called from any task.
+ * @param   co  coroutine to start.
+ * @return  false if coroutine frame could not be allocated.
+ */
+    inline bool spawn(CoTask&& co)
+    {
+      POS_LOCKFLAGS;
+
+      if (!co.valid())
+        return false;
+
+      Promise* p = &co.handle.promise();
+
+      co.handle = CoTask::Handle();
+      p->executor = this;
+
+      POS_SCHED_LOCK;
+      ++live;
+      POS_SCHED_UNLOCK;
+
+      schedule(p);
+      notify();
+      return true;
+    }
+
+/**
+ * Wakes up executor to check kernel objects immediately.
+ * Can be called from tasks and software interrupt handlers.
+ */
+    inline void notify()
+    {
+      wake.signal();
+    }
+
+/**
+ * Resumes all ready coroutines once and checks waiting ones.
+ * Must be called from executor task.
+ * @return  number of resumed coroutines.
+ */
+    inline UINT_t poll()
+    {
+      POS_LOCKFLAGS;
+      UINT_t count = 0;
+      JIF_t now = jiffies;
+      Waiter** wp = &waiters;
+      Promise* p;
+      bool polled = false;
+      bool hit = false;
+
+      while (*wp != NULL) {
+
+        Waiter* w = *wp;
+
+        if (w->check != NULL) {
+
+          polled = true;
+          if (w->check(w)) {
+
+            hit = true;
+            *wp = w->next;
+            schedule(w->promise);
+            continue;
+          }
+        }
+
+        if (w->timed && !POS_TIMEAFTER(w->deadline, now)) {
+
+          w->expired = true;
+          *wp = w->next;
+          schedule(w->promise);
+          continue;
+        }
+
+        wp = &w->next;
+      }
+
+      backoff(polled, hit, now);
+
+      POS_SCHED_LOCK;
+      p = readyHead;
+      readyHead = readyTail = NULL;
+      POS_SCHED_UNLOCK;
+
+      while (p != NULL) {
+
+        CoTask::Handle h = CoTask::Handle::from_promise(*p);
+
+        p = p->next;
+        h.resume();
+        ++count;
+        if (h.done()) {
+
+          h.destroy();
+          POS_SCHED_LOCK;
+          --live;
+          POS_SCHED_UNLOCK;
+        }
+      }
+
+      nextWait = waitTime();
+      return count;
+    }
+
+/**
+ * Runs coroutines forever. Sleeps when there is nothing to do.
+ */
+    inline void run()
+    {
+      for (;;) {
+
+        poll();
+        if (nextWait != 0)
+          wake.wait(nextWait);
+      }
+    }
+
+/**
+ * Task function that runs executor given as argument.
+ * Can be passed directly to ::pos::Task::create.
+ */
+    static inline void task(void* executor)
+    {
+      static_cast<Executor*>(executor)->run();
+    }
+
+/**
+ * Returns number of coroutines that have not finished yet.
+ */
+    inline UINT_t count() const
+    {
+      return live;
+    }
+
+/*
+ * Used by awaitables.
+ */
+    inline void schedule(Promise* p)
+    {
+      POS_LOCKFLAGS;
+
+      p->next = NULL;
+      POS_SCHED_LOCK;
+      if (readyTail == NULL)
+        readyHead = p;
+      else
+        readyTail->next = p;
+
+      readyTail = p;
+      POS_SCHED_UNLOCK;
+    }
+
+    inline void suspend(Waiter* w)
+    {
+      w->next = waiters;
+      waiters = w;
+      if (w->check != NULL) {
+
+        pollInterval = 1;
+        pollStamp = jiffies;
+      }
+    }
+
+  private:
+
+/*
+ * Adjust polling interval. Interval is reset when a polled
+ * object became ready. Otherwise it is doubled when it has
+ * been in use for its full length, so that it grows with
+ * time and not with number of polls done for other reasons.
+ */
+    inline void backoff(bool polled, bool hit, JIF_t now)
+    {
+      if (hit) {
+
+        pollInterval = 1;
+        pollStamp = now;
+      }
+      else if (polled && (JIF_t)(now - pollStamp) >= pollInterval) {
+
+        pollInterval *= 2;
+        if (pollInterval > OOCFG_CORO_POLL_MAX)
+          pollInterval = (OOCFG_CORO_POLL_MAX > 0) ? OOCFG_CORO_POLL_MAX : 1;
+
+        pollStamp = now;
+      }
+    }
+
+/*
+ * Compute how long executor can sleep. Waiters are scanned
+ * after coroutines have been resumed, so waiters registered
+ * during this poll are included.
+ */
+    inline UINT_t waitTime()
+    {
+      POS_LOCKFLAGS;
+      bool ready;
+      bool polled = false;
+      bool timed = false;
+      JIF_t nearest = 0;
+      JIF_t now;
+
+      POS_SCHED_LOCK;
+      ready = (readyHead != NULL);
+      POS_SCHED_UNLOCK;
+
+      if (ready)
+        return 0;
+
+      for (Waiter* w = waiters; w != NULL; w = w->next) {
+
+        if (w->check != NULL)
+          polled = true;
+
+        if (w->timed && (!timed || POS_TIMEAFTER(nearest, w->deadline))) {
+
+          nearest = w->deadline;
+          timed = true;
+        }
+      }
+
+      if (!timed)
+        return polled ? pollInterval : INFINITE;
+
+      now = jiffies;
+      if (!POS_TIMEAFTER(nearest, now))
+        return 0;
+
+      if (polled && pollInterval < (UINT_t)(nearest - now))
+        return pollInterval;
+
+      return (UINT_t)(nearest - now);
+    }
+
+    Promise* readyHead;
+    Promise* readyTail;
+    Waiter* waiters;
+    UINT_t live;
+    UINT_t nextWait;
+    UINT_t pollInterval;
+    JIF_t pollStamp;
+    Sema wake;
+
+    Executor(const Executor&);
+    Executor& operator=(const Executor&);
+  };
+
+/*
+ * Common part of awaitables that wait for kernel
+ * object or deadline.
+ */
+  class CoWait : protected Executor::Waiter
+  {
+  public:
+    inline bool await_ready()
+    {
+      if (check != NULL && check(this))
+        return true;
+
+      if (timed && !POS_TIMEAFTER(deadline, jiffies)) {
+
+        expired = true;
+        return true;
+      }
+
+      return false;
+    }
+
+    inline void await_suspend(CoTask::Handle h)
+    {
+      promise = &h.promise();
+      promise->executor->suspend(this);
+    }
+
+  protected:
+    inline CoWait(bool (*f)(Executor::Waiter*), UINT_t timeout)
+    {
+      next = NULL;
+      promise = NULL;
+      check = f;
+      timed = (timeout != INFINITE);
+      deadline = jiffies + timeout;
+      expired = false;
+    }
+  };
+
+/**
+ * Awaitable for ::pos::Sema. Result of co_await is
+ * same as with ::pos::Sema::wait: 0 when semaphore was
+ * taken, 1 on timeout.
+ */
+  class AwaitSema : public CoWait
+  {
+  public:
+    inline AwaitSema(Sema& s, UINT_t timeout = INFINITE) : CoWait(poll, timeout), sema(s)
+    {
+    }
+
+    inline VAR_t await_resume()
+    {
+      return expired ? 1 : 0;
+    }
+
+  private:
+    static inline bool poll(Executor::Waiter* w)
+    {
+      return static_cast<AwaitSema*>(w)->sema.wait(0) == 0;
+    }
+
+    Sema& sema;
+  };
+
+#if DOX!=0 || (POSCFG_FEATURE_FLAGS != 0 && POSCFG_FEATURE_FLAGWAIT != 0)
+/**
+ * Awaitable for ::pos::Flag. Result of co_await is
+ * same as with ::pos::Flag::wait: mask of flags that were set,
+ * 0 on timeout.
+ * @note    ::POSCFG_FEATURE_FLAGWAIT must be defined to 1
+ *          to have this class compiled in.
+ */
+  class AwaitFlag : public CoWait
+  {
+  public:
+    inline AwaitFlag(Flag& f, UINT_t timeout = INFINITE) : CoWait(poll, timeout), flag(f), flags(0)
+    {
+    }
+
+    inline VAR_t await_resume()
+    {
+      return flags;
+    }
+
+  private:
+    static inline bool poll(Executor::Waiter* w)
+    {
+      AwaitFlag* a = static_cast<AwaitFlag*>(w);
+
+      a->flags = a->flag.wait(0);
+      return a->flags > 0;
+    }
+
+    Flag& flag;
+    VAR_t flags;
+  };
+#endif
+
+#if DOX!=0 || POSCFG_FEATURE_MSGBOXES != 0
+/**
+ * Awaitable for message sent to executor task. Result of
+ * co_await is pointer to message buffer, or NULL on timeout.
+ * Message must be freed as usual.
+ */
+  class AwaitMessage : public CoWait
+  {
+  public:
+    inline AwaitMessage(UINT_t timeout = INFINITE) : CoWait(poll, timeout), msg(NULL)
+    {
+    }
+
+    inline void* await_resume()
+    {
+      return msg;
+    }
+
+  private:
+    static inline bool poll(Executor::Waiter* w)
+    {
+      AwaitMessage* a = static_cast<AwaitMessage*>(w);
+
+      if (!::posMessageAvailable())
+        return false;
+
+      a->msg = ::posMessageGet();
+      return true;
+    }
+
+    void* msg;
+  };
+#endif
+
+#if DOX!=0 || (POSCFG_FEATURE_TIMER != 0 && POSCFG_FEATURE_TIMERFIRED != 0)
+/**
+ * Awaitable for ::pos::Timer. Completes when timer has fired.
+ * Result of co_await is 0 when timer fired, 1 on timeout.
+ * @note    ::POSCFG_FEATURE_TIMERFIRED must be defined to 1
+ *          to have this class compiled in.
+ */
+  class AwaitTimer : public CoWait
+  {
+  public:
+    inline AwaitTimer(Timer& t, UINT_t timeout = INFINITE) : CoWait(poll, timeout), timer(t)
+    {
+    }
+
+    inline VAR_t await_resume()
+    {
+      return expired ? 1 : 0;
+    }
+
+  private:
+    static inline bool poll(Executor::Waiter* w)
+    {
+      return static_cast<AwaitTimer*>(w)->timer.fired() == 1;
+    }
+
+    Timer& timer;
+  };
+#endif
+
+/**
+ * Awaitable that replaces ::pos::Task::sleep.
+ */
+  class AwaitSleep : public CoWait
+  {
+  public:
+    inline AwaitSleep(UINT_t ticks) : CoWait(NULL, ticks)
+    {
+    }
+
+    inline void await_resume()
+    {
+    }
+  };
+
+/**
+ * Awaitable that completes when ::jiffies reaches given deadline.
+ * Useful for periodic activities that must not drift.
+ */
+  class AwaitDeadline : public CoWait
+  {
+  public:
+    inline AwaitDeadline(JIF_t when) : CoWait(NULL, 0)
+    {
+      deadline = when;
+    }
+
+    inline void await_resume()
+    {
+    }
+  };
+
+/**
+ * Awaitable that lets other ready coroutines run,
+ * like ::pos::Task::yield.
+ */
+  class AwaitYield
+  {
+  public:
+    inline bool await_ready()
+    {
+      return false;
+    }
+
+    inline void await_suspend(CoTask::Handle h)
+    {
+      h.promise().executor->schedule(&h.promise());
+    }
+
+    inline void await_resume()
+    {
+    }
+  };
+
+/**
+ * Counting semaphore for coroutines of one executor.
+ * Signaling resumes a waiting coroutine directly without
+ * polling, so this is the fastest way for coroutines to
+ * wait for each other.
+ * @note    Must be used only from coroutines and executor task.
+ *          Use ::pos::Sema with ::pos::AwaitSema when other
+ *          tasks are involved.
+ */
+  class CoSema
+  {
+  public:
+    class Awaiter
+    {
+    public:
+      inline Awaiter(CoSema& s) : sema(s)
+      {
+      }
+
+      inline bool await_ready()
+      {
+        if (sema.counter > 0) {
+
+          --sema.counter;
+          return true;
+        }
+
+        return false;
+      }
+
+      inline void await_suspend(CoTask::Handle h)
+      {
+        Executor::Promise* p = &h.promise();
+
+        p->next = NULL;
+        if (sema.tail == NULL)
+          sema.head = p;
+        else
+          sema.tail->next = p;
+
+        sema.tail = p;
+      }
+
+      inline void await_resume()
+      {
+      }
+
+    private:
+      CoSema& sema;
+    };
+
+/* 
+ * Constructors.
+ */
+    inline CoSema(INT_t initial = 0) : counter(initial), head(NULL), tail(NULL)
+    {
+    }
+
+/**
+ * Signals semaphore. If a coroutine is waiting, it is made ready.
+ */
+    inline void signal()
+    {
+      Executor::Promise* p = head;
+
+      if (p == NULL) {
+
+        ++counter;
+        return;
+      }
+
+      head = p->next;
+      if (head == NULL)
+        tail = NULL;
+
+      p->executor->schedule(p);
+    }
+
+/**
+ * Returns awaitable that takes semaphore:
+ * co_await sema.wait().
+ */
+    inline Awaiter wait()
+    {
+      return Awaiter(*this);
+    }
+
+  private:
+    INT_t counter;
+    Executor::Promise* head;
+    Executor::Promise* tail;
+
+    CoSema(const CoSema&);
+    CoSema& operator=(const CoSema&);
+  };
+}
+
+#endif /* __cpp_impl_coroutine */
+#endif /* _PICOOS_COROUTINE_HXX */
@@ -203,14 +203,23 @@ namespace nos {
  */
     inline Flag()
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = NULL;
+#endif
     };
 
     inline Flag(const Flag& other) : pos::Flag(other)
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = other.stats;
+#endif
     };
 
     inline Flag(const POSFLAG_t other) : pos::Flag(other)
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = NULL;
+#endif
     };
 
 #if DOX!=0 || NOSCFG_FEATURE_FLAGS != 0
@@ -241,7 +250,13 @@ namespace nos {
     inline VAR_t create(const char *name)
     {
       handle = nosFlagCreate(name);
-      return (handle == NULL) ? -1 : 0;
+      if (handle == NULL)
+        return -1;
+
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = Instrument::attach(name, "flag");
+#endif
+      return 0;
     };
 
     using pos::Flag::create;
@@ -259,6 +274,10 @@ namespace nos {
  */
     inline void destroy()
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      Instrument::detach(stats);
+      stats = NULL;
+#endif
       nosFlagDestroy(handle);
       handle = (POSFLAG_t)0;
     }
@@ -266,6 +285,49 @@ namespace nos {
 #endif
 #endif /* NOSCFG_FEATURE_FLAGS */
 
+#if DOX!=0 || OOCFG_FEATURE_INSTRUMENT != 0
+/**
+ * Waits for flags, see ::pos::Flag::get.
+ * Flags cannot be tested without clearing them, so acquire
+ * is counted as contended when the call blocked for at
+ * least one timer tick.
+ * @note    ::OOCFG_FEATURE_INSTRUMENT must be defined to 1
+ *          to have this function compiled in.
+ */
+    inline VAR_t get(UVAR_t mode)
+    {
+      JIF_t start = jiffies;
+      VAR_t status = pos::Flag::get(mode);
+
+      if (stats != NULL && status >= 0)
+        stats->acquired(start, jiffies != start);
+
+      return status;
+    }
+
+#if DOX!=0 || POSCFG_FEATURE_FLAGWAIT != 0
+/**
+ * Waits for flags with timeout, see ::pos::Flag::wait.
+ * Acquires are recorded like in ::nos::Flag::get.
+ * @note    ::OOCFG_FEATURE_INSTRUMENT must be defined to 1
+ *          to have this function compiled in.
+ */
+    inline VAR_t wait(UINT_t timeoutticks)
+    {
+      JIF_t start = jiffies;
+      VAR_t status = pos::Flag::wait(timeoutticks);
+
+      if (stats != NULL && status > 0)
+        stats->acquired(start, jiffies != start);
+
+      return status;
+    }
+#endif
+
+  private:
+    LockStats* stats;
+#endif /* OOCFG_FEATURE_INSTRUMENT */
+
   };
 }
 
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-instrument.hxx
+ * @brief   Pico]OS oo-wrapper Instrument
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_INSTRUMENT_HXX
+#define _PICOOS_INSTRUMENT_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+/**
+ * Enable contention and latency instrumentation of named
+ * ::nos::Mutex, ::nos::Sema and ::nos::Flag objects. When set to 0
+ * (default), instrumentation compiles to nothing.
+ * Can be defined in noscfg.h.
+ */
+#ifndef OOCFG_FEATURE_INSTRUMENT
+#define OOCFG_FEATURE_INSTRUMENT 0
+#endif
+
+/**
+ * Maximum number of instrumented objects. Objects created
+ * after the table is full are not instrumented.
+ */
+#ifndef OOCFG_INSTRUMENT_MAX
+#define OOCFG_INSTRUMENT_MAX 32
+#endif
+
+#if DOX!=0 || (OOCFG_FEATURE_INSTRUMENT != 0 && POSCFG_ENABLE_NANO != 0)
+
+#if POSCFG_FEATURE_JIFFIES == 0 || POSCFG_FEATURE_GETTASK == 0
+#error OOCFG_FEATURE_INSTRUMENT requires POSCFG_FEATURE_JIFFIES and POSCFG_FEATURE_GETTASK
+#endif
+
+namespace nos {
+
+/**
+ * Statistics of one instrumented object. All times are
+ * in timer ticks.
+ */
+  struct LockStats
+  {
+    const char* name;        //!< name given when object was created
+    const char* kind;        //!< "mutex", "sema" or "flag"
+    UINT_t      acquires;    //!< successful lock/get/wait calls
+    UINT_t      contended;   //!< acquires that had to block
+    UINT_t      totalWait;   //!< sum of blocking times
+    UINT_t      maxWait;     //!< longest blocking time
+    UINT_t      maxHold;     //!< longest time mutex was held
+    POSTASK_t   owner;       //!< task that acquired object last
+    JIF_t       holdStart;
+    UVAR_t      depth;
+
+/*
+ * Record acquire that started waiting at given time.
+ */
+    inline void acquired(JIF_t start, UVAR_t blocked)
+    {
+      POS_LOCKFLAGS;
+      UINT_t wait = (UINT_t)(jiffies - start);
+      POSTASK_t self = posTaskGetCurrent();
+
+      POS_SCHED_LOCK;
+      ++acquires;
+      if (blocked)
+        ++contended;
+
+      totalWait += wait;
+      if (wait > maxWait)
+        maxWait = wait;
+
+      owner = self;
+      POS_SCHED_UNLOCK;
+    }
+
+/*
+ * Record mutex lock. Hold time is measured
+ * from outermost lock to outermost unlock.
+ */
+    inline void locked(JIF_t start, UVAR_t blocked)
+    {
+      acquired(start, blocked);
+      if (depth++ == 0)
+        holdStart = jiffies;
+    }
+
+    inline void unlocked()
+    {
+      if (depth > 0 && --depth == 0) {
+
+        UINT_t hold = (UINT_t)(jiffies - holdStart);
+        if (hold > maxHold)
+          maxHold = hold;
+      }
+    }
+  };
+
+/**
+ * Registry of instrumented objects. Named ::nos::Mutex, ::nos::Sema
+ * and ::nos::Flag objects are registered automatically when they
+ * are created, if ::OOCFG_FEATURE_INSTRUMENT is set to 1.
+ * Statistics can be printed to console to find out which
+ * objects are contended or cause long waits.
+ */
+  class Instrument
+  {
+  private:
+    inline Instrument()
+    {
+    };
+
+  public:
+/*
+ * Allocate statistics for a new object. Returns NULL
+ * if table is full.
+ */
+    static LockStats* attach(const char* name, const char* kind);
+
+/*
+ * Free statistics of destroyed object.
+ */
+    static void detach(LockStats* stats);
+
+/**
+ * Clears statistics of all instrumented objects.
+ */
+    static void reset();
+
+/**
+ * Gets statistics of an instrumented object.
+ * @param   index  index of object, 0 .. ::OOCFG_INSTRUMENT_MAX - 1.
+ * @return  statistics or NULL if there is no object at index.
+ */
+    static const LockStats* get(UINT_t index);
+
+#if DOX!=0 || (NOSCFG_FEATURE_CONOUT != 0 && NOSCFG_FEATURE_PRINTF != 0 && NOSCFG_FEATURE_USE_STDARG != 0)
+/**
+ * Prints statistics of objects with longest total wait times
+ * using ::nos::Console.
+ * @param   count  maximum number of objects to print.
+ * @note    ::NOSCFG_FEATURE_CONOUT and ::NOSCFG_FEATURE_PRINTF
+ *          must be defined to 1 to have this function compiled in.
+ */
+    static void report(UINT_t count);
+#endif
+  };
+}
+
+#endif /* OOCFG_FEATURE_INSTRUMENT */
+#endif /* _PICOOS_INSTRUMENT_HXX */
@@ -0,0 +1,399 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-log.hxx
+ * @brief   Pico]OS oo-wrapper asynchronous Log
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_LOG_HXX
+#define _PICOOS_LOG_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+/**
+ * Number of records in ::nos::Log buffer. Must be a power of two.
+ * Can be defined in noscfg.h.
+ */
+#ifndef OOCFG_LOG_RECORDS
+#define OOCFG_LOG_RECORDS 64
+#endif
+
+/**
+ * Maximum number of arguments in one log record.
+ */
+#ifndef OOCFG_LOG_ARGS
+#define OOCFG_LOG_ARGS 4
+#endif
+
+/**
+ * Interval in timer ticks at which drain task of ::nos::Log
+ * flushes buffered records even if buffer is not half full.
+ */
+#ifndef OOCFG_LOG_FLUSH_TICKS
+#define OOCFG_LOG_FLUSH_TICKS MS(100)
+#endif
+
+/**
+ * Use compare-and-swap to reserve records in ::nos::Log buffer.
+ * Defaults to ::OOCFG_ATOMIC_NATIVE. When 0, scheduler is
+ * locked for the few instructions needed to reserve a record.
+ */
+#ifndef OOCFG_LOG_LOCKFREE
+#define OOCFG_LOG_LOCKFREE OOCFG_ATOMIC_NATIVE
+#endif
+
+#if DOX!=0 || (NOSCFG_FEATURE_CONOUT != 0 && POSCFG_FEATURE_SEMAPHORES != 0)
+
+namespace nos {
+
+/*
+ * Argument kinds of log records: 'i' signed integer,
+ * 'u' unsigned integer, 'l' signed long, 'L' unsigned long,
+ * 'c' character, 's' string and 'p' pointer.
+ * Kinds are used both for storing arguments and for checking
+ * format strings at compile time.
+ */
+  union LogArg
+  {
+    INT_t i;
+    UINT_t u;
+    long li;
+    unsigned long lu;
+    const char* s;
+    const void* p;
+  };
+
+  template<typename T>
+  struct LogKind;
+
+  template<typename T>
+  struct LogKind<T*>
+  {
+    static const char kind = 'p';
+    static inline void set(LogArg& a, const T* v) { a.p = v; }
+  };
+
+  template<>
+  struct LogKind<char*>
+  {
+    static const char kind = 's';
+    static inline void set(LogArg& a, const char* v) { a.s = v; }
+  };
+
+  template<>
+  struct LogKind<const char*> : LogKind<char*>
+  {
+  };
+
+  template<unsigned int N>
+  struct LogKind<char[N]> : LogKind<char*>
+  {
+  };
+
+  template<unsigned int N>
+  struct LogKind<const char[N]> : LogKind<char*>
+  {
+  };
+
+  template<typename T, char K>
+  struct LogInt
+  {
+    static_assert(K == 'l' || K == 'L' || sizeof(T) <= sizeof(INT_t),
+                  "log argument does not fit in INT_t");
+
+    static const char kind = K;
+    static inline void set(LogArg& a, T v)
+    {
+      if (K == 'l')
+        a.li = (long)v;
+      else if (K == 'L')
+        a.lu = (unsigned long)v;
+      else if (K == 'u')
+        a.u = (UINT_t)v;
+      else
+        a.i = (INT_t)v;
+    }
+  };
+
+  template<> struct LogKind<char>           : LogInt<char, 'c'> {};
+  template<> struct LogKind<bool>           : LogInt<bool, 'i'> {};
+  template<> struct LogKind<signed char>    : LogInt<signed char, 'i'> {};
+  template<> struct LogKind<unsigned char>  : LogInt<unsigned char, 'u'> {};
+  template<> struct LogKind<short>          : LogInt<short, 'i'> {};
+  template<> struct LogKind<unsigned short> : LogInt<unsigned short, 'u'> {};
+  template<> struct LogKind<int>            : LogInt<int, 'i'> {};
+  template<> struct LogKind<unsigned int>   : LogInt<unsigned int, 'u'> {};
+  template<> struct LogKind<long>           : LogInt<long, 'l'> {};
+  template<> struct LogKind<unsigned long>  : LogInt<unsigned long, 'L'> {};
+
+/*
+ * Compile-time format string checking. Each conversion
+ * must have a matching argument and there must not be
+ * extra arguments. Long arguments need 'l' modifier
+ * and 'l' is accepted only for them.
+ */
+  struct LogFormat
+  {
+    static constexpr const char* conversion(const char* f)
+    {
+      return (*f == '-' || (*f >= '0' && *f <= '9')) ? conversion(f + 1) : f;
+    }
+
+    static constexpr bool integer(char c)
+    {
+      return c == 'd' || c == 'i' || c == 'u' || c == 'x' || c == 'X';
+    }
+
+    static constexpr bool fits(const char* f, char kind)
+    {
+      return (*f == 'l') ? (integer(f[1]) && (kind == 'l' || kind == 'L')) :
+             (*f == 's') ? kind == 's' :
+             (*f == 'p') ? (kind == 'p' || kind == 's') :
+             (integer(*f) || *f == 'c') ?
+               (kind == 'i' || kind == 'u' || kind == 'c') :
+             false;
+    }
+
+    static constexpr const char* next(const char* f)
+    {
+      return (*f == 'l') ? f + 2 : f + 1;
+    }
+  };
+
+  template<char... K>
+  struct LogTypes;
+
+  template<>
+  struct LogTypes<>
+  {
+    static constexpr bool check(const char* f)
+    {
+      return (*f == '\0') ? true :
+             (*f != '%') ? check(f + 1) :
+             (f[1] == '%') ? check(f + 2) :
+             false;
+    }
+  };
+
+  template<char K, char... Rest>
+  struct LogTypes<K, Rest...>
+  {
+    static constexpr bool check(const char* f)
+    {
+      return (*f == '\0') ? false :
+             (*f != '%') ? check(f + 1) :
+             (f[1] == '%') ? check(f + 2) :
+             LogFormat::fits(LogFormat::conversion(f + 1), K) &&
+               LogTypes<Rest...>::check(LogFormat::next(LogFormat::conversion(f + 1)));
+    }
+  };
+
+/**
+ * Asynchronous log. Writing a log record only stores format string
+ * pointer and raw argument values into a lock-free buffer, formatting
+ * and output through ::nosPrintChar is done later by a low priority
+ * drain task. This keeps slow console output away from time critical
+ * code and uses very little stack in calling task. If buffer is full,
+ * record is dropped and drop counter is incremented instead of
+ * blocking. Drain task reports number of dropped records.@n
+ * @n
+ * Records should be written with ::NOS_LOG macro, which checks
+ * format string against arguments at compile time.
+ * Supported conversions are %%d, %%i, %%u, %%x, %%X, %%c, %%s and %%p
+ * with optional '-' and '0' flags and field width. Long arguments
+ * are printed with %%ld, %%li, %%lu, %%lx and %%lX.
+ * @note    Because formatting is deferred, strings given as %%s
+ *          arguments must stay valid until record has been printed
+ *          (string literals are always safe).
+ * @code
+ * static nos::Log log;
+ *
+ * log.start(1, 512);
+ * NOS_LOG(log, "speed %d rpm, state %s\n", rpm, stateName);
+ * @endcode
+ */
+  class Log
+  {
+  public:
+
+/* 
+ * Constructors.
+ */
+    Log();
+
+/**
+ * Creates semaphore used to wake up drain task.
+ * Needed only if drain task is not started with ::nos::Log::start.
+ * @return  zero on success, -1 on failure.
+ */
+    VAR_t create();
+
+#if DOX!=0 || NOSCFG_FEATURE_TASKCREATE != 0
+/**
+ * Creates drain task and semaphore used to wake it up.
+ * Records written before start are buffered.
+ * @param   priority   priority of drain task, typically low.
+ * @param   stacksize  stack size of drain task.
+ * @return  zero on success, -1 on failure.
+ * @note    ::NOSCFG_FEATURE_TASKCREATE must be defined to 1
+ *          to have this function compiled in.
+ */
+    VAR_t start(VAR_t priority, UINT_t stacksize);
+#endif
+
+/**
+ * Writes a log record. Can be called from tasks and
+ * software interrupt handlers. Format string is not checked,
+ * use ::NOS_LOG macro for that.
+ * @param   fmt   format string, must stay valid until printed.
+ * @param   args  arguments (integers, characters, strings or pointers).
+ * @return  true if record was stored, false if it was dropped.
+ */
+    template<typename... A>
+    inline bool write(const char* fmt, const A&... args)
+    {
+      static_assert(sizeof...(A) <= OOCFG_LOG_ARGS, "too many log arguments");
+      UINT_t pos;
+      Record* r = reserve(pos);
+
+      if (r == NULL)
+        return false;
+
+      r->fmt = fmt;
+      r->count = sizeof...(A);
+      store(r->args, args...);
+      publish(pos);
+      return true;
+    }
+
+/**
+ * Wakes up drain task to print all buffered records.
+ */
+    void flush();
+
+/**
+ * Formats and prints all buffered records in the context
+ * of calling task. Normally called by drain task.
+ * @return  number of printed records.
+ */
+    UINT_t process();
+
+/**
+ * Drain task function, argument must point to ::nos::Log.
+ * Started by ::nos::Log::start, but can be used also directly
+ * with ::pos::Task::create.
+ */
+    static void task(void* log);
+
+/**
+ * Returns number of records dropped because buffer was full.
+ */
+    inline UINT_t dropped() const
+    {
+      return __atomic_load_n(&drops, __ATOMIC_RELAXED);
+    }
+
+/*
+ * Used by NOS_LOG macro to get argument kinds, never called.
+ */
+    template<typename... A>
+    static LogTypes<LogKind<A>::kind...> types(const char* fmt, const A&... args);
+
+  private:
+    enum {
+      SIZE = OOCFG_LOG_RECORDS
+    };
+
+    struct Record
+    {
+      UINT_t seq;
+      const char* fmt;
+      UINT_t count;
+      LogArg args[OOCFG_LOG_ARGS];
+    };
+
+    static_assert((SIZE & (SIZE - 1)) == 0, "OOCFG_LOG_RECORDS must be a power of two");
+
+    Record* reserve(UINT_t& pos);
+    void publish(UINT_t pos);
+    static void print(const Record* r);
+
+    static inline void store(LogArg*)
+    {
+    }
+
+    template<typename T, typename... R>
+    static inline void store(LogArg* a, const T& v, const R&... rest)
+    {
+      LogKind<T>::set(*a, v);
+      store(a + 1, rest...);
+    }
+
+    Record records[SIZE];
+    UINT_t head;
+    UINT_t tail;
+    UINT_t drops;
+    UINT_t reported;
+    bool running;
+    pos::Sema ready;
+
+    Log(const Log&);
+    Log& operator=(const Log&);
+  };
+}
+
+/*
+ * Helper for NOS_LOG, picks format from argument list.
+ */
+#define NOS_LOG_FMT_(fmt, ...) fmt
+
+/**
+ * Writes a record to ::nos::Log. Format string must be
+ * a string literal. Number and kinds of arguments are checked
+ * against format at compile time.
+ * @param   log  ::nos::Log object.
+ * @param   ...  format string and arguments.
+ * @sa      ::nos::Log::write
+ */
+#define NOS_LOG(log, ...) \
+  do { \
+    static_assert(decltype(::nos::Log::types(__VA_ARGS__))::check(NOS_LOG_FMT_(__VA_ARGS__, 0)), \
+                  "log format does not match arguments"); \
+    (log).write(__VA_ARGS__); \
+  } while (0)
+
+#endif /* NOSCFG_FEATURE_CONOUT */
+#endif /* _PICOOS_LOG_HXX */
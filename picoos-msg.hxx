@@ -89,6 +89,45 @@ namespace pos {
     };
 #endif
 
+#if (DOX!=0) || (POSCFG_MSG_MEMORY == 0)
+/**
+ * Allocates a message buffer from a fixed-block pool.
+ * When ::POSCFG_MSG_MEMORY is 0 message boxes carry only pointers
+ * to user supplied buffers, so a ::pos::Pool can be used to
+ * get bounded allocation time for message buffers.
+ * @param   pool  pool to allocate buffer from.
+ * @return  the pointer to the new buffer. NULL is returned when
+ *          all pool blocks are in use.
+ * @note    ::POSCFG_MSG_MEMORY must be defined to 0
+ *          to have this function compiled in.
+ * @sa      free, send, ::pos::Pool
+ */
+    template<class T, UINT_t N>
+    inline T* alloc(Pool<T, N>& pool)
+    {
+      T* buf = pool.alloc();
+
+      msg = buf;
+      return buf;
+    }
+
+/**
+ * Returns a message buffer back to the pool it was allocated from.
+ * Usually the receiving task would call this function after
+ * it has processed a message.
+ * @param   pool  pool the buffer was allocated from.
+ * @note    ::POSCFG_MSG_MEMORY must be defined to 0
+ *          to have this function compiled in.
+ * @sa      alloc, get, ::pos::Pool
+ */
+    template<class T, UINT_t N>
+    inline void free(Pool<T, N>& pool)
+    {
+      pool.free(static_cast<T*>(msg));
+      msg = NULL;
+    }
+#endif
+
 #if (DOX!=0) || (POSCFG_MSG_MEMORY != 0)
 /**
  * Allocates a new message buffer. The maximum buffer size is
@@ -217,7 +256,7 @@ namespace pos {
       return *this;
     };
 
-  private:
+  protected:
     void* msg;
   };
 }
@@ -268,6 +307,11 @@ namespace nos {
       return msg;
     }
 
+#if DOX!=0 || POSCFG_MSG_MEMORY == 0
+    using pos::Message::alloc;
+    using pos::Message::free;
+#endif
+
 /**
  * Frees a message buffer again.
  * Usually the receiving task would call this function after
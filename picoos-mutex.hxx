@@ -195,14 +195,23 @@ namespace nos {
  */
     inline Mutex()
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = NULL;
+#endif
     };
 
     inline Mutex(const Mutex& other) : pos::Mutex(other)
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = other.stats;
+#endif
     };
 
     inline Mutex(const POSMUTEX_t other) : pos::Mutex(other)
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = NULL;
+#endif
     };
 
 #if DOX!=0 || NOSCFG_FEATURE_MUTEXES != 0
@@ -230,7 +239,13 @@ namespace nos {
     inline VAR_t create(UVAR_t options, const char *name)
     {
       handle = nosMutexCreate(options, name);
-      return (handle == NULL) ? -1 : 0;
+      if (handle == NULL)
+        return -1;
+
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = Instrument::attach(name, "mutex");
+#endif
+      return 0;
     };
 
     using pos::Mutex::create;
@@ -248,6 +263,10 @@ namespace nos {
  */
     inline void destroy()
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      Instrument::detach(stats);
+      stats = NULL;
+#endif
       nosMutexDestroy(handle);
       handle = (POSMUTEX_t)0;
     }
@@ -255,6 +274,84 @@ namespace nos {
 #endif
 #endif /* NOSCFG_FEATURE_MUTEXES */
 
+#if DOX!=0 || OOCFG_FEATURE_INSTRUMENT != 0
+
+#if DOX!=0 || POSCFG_FEATURE_MUTEXTRYLOCK != 0
+/**
+ * Tries to get the mutex lock, see ::pos::Mutex::tryLock.
+ * Failed attempt is counted as contention.
+ * @note    ::OOCFG_FEATURE_INSTRUMENT must be defined to 1
+ *          to have this function compiled in.
+ */
+    inline VAR_t tryLock()
+    {
+      JIF_t start = jiffies;
+      VAR_t status = pos::Mutex::tryLock();
+
+      if (stats != NULL) {
+
+        if (status == 0)
+          stats->locked(start, 0);
+        else if (status > 0)
+          ++stats->contended;
+      }
+
+      return status;
+    }
+#endif
+
+/**
+ * Locks the mutex, see ::pos::Mutex::lock.
+ * If mutex is held by another task, acquire is counted as
+ * contended and time spent waiting is recorded.
+ * @note    ::OOCFG_FEATURE_INSTRUMENT must be defined to 1
+ *          to have this function compiled in.
+ */
+    inline VAR_t lock()
+    {
+      JIF_t start;
+      UVAR_t blocked = 0;
+      VAR_t status;
+
+      if (stats == NULL)
+        return pos::Mutex::lock();
+
+      start = jiffies;
+#if POSCFG_FEATURE_MUTEXTRYLOCK != 0
+      status = pos::Mutex::tryLock();
+      if (status > 0) {
+
+        blocked = 1;
+        status = pos::Mutex::lock();
+      }
+#else
+      status = pos::Mutex::lock();
+#endif
+
+      if (status == 0)
+        stats->locked(start, blocked);
+
+      return status;
+    }
+
+/**
+ * Unlocks the mutex, see ::pos::Mutex::unlock.
+ * Time mutex was held is recorded.
+ * @note    ::OOCFG_FEATURE_INSTRUMENT must be defined to 1
+ *          to have this function compiled in.
+ */
+    inline VAR_t unlock()
+    {
+      if (stats != NULL)
+        stats->unlocked();
+
+      return pos::Mutex::unlock();
+    }
+
+  private:
+    LockStats* stats;
+#endif /* OOCFG_FEATURE_INSTRUMENT */
+
   };
 }
 
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-pool.hxx
+ * @brief   Pico]OS oo-wrapper Pool and Arena
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_POOL_HXX
+#define _PICOOS_POOL_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+#include <stddef.h>
+#include <new>
+
+namespace pos {
+
+/**
+ * Fixed-block memory pool. Pool contains storage for N objects
+ * of type T. Allocation and freeing take constant time (blocks are
+ * kept in an intrusive free list) and are allowed also from
+ * software interrupt handlers, so pool can be used instead of
+ * dynamic memory allocator when allocation time must be bounded
+ * and fragmentation cannot be tolerated.@n
+ * @n
+ * Pool keeps track of the maximum number of blocks that have
+ * been in use simultaneously (::pos::Pool::highWater). This can
+ * be used to size pools according to measurements.
+ * @code
+ * static pos::Pool<Request, 8> requests;
+ *
+ * Request* r = requests.construct(id);
+ * ...
+ * requests.destroy(r);
+ * @endcode
+ */
+  template<class T, UINT_t N>
+  class Pool
+  {
+  public:
+    static_assert(N > 0, "Pool must have at least one block");
+
+/* 
+ * Constructors.
+ */
+    inline Pool()
+    {
+      for (UINT_t i = 0; i < N - 1; ++i)
+        blocks[i].next = &blocks[i + 1];
+
+      blocks[N - 1].next = NULL;
+      freeList = blocks;
+      inUse = 0;
+      maxInUse = 0;
+    }
+
+/**
+ * Allocates an uninitialized block from pool.
+ * @return  pointer to block. NULL is returned if all
+ *          blocks are in use.
+ * @sa      free, construct
+ */
+    inline T* alloc()
+    {
+      POS_LOCKFLAGS;
+      Block* b;
+
+      POS_SCHED_LOCK;
+      b = freeList;
+      if (b != NULL) {
+
+        freeList = b->next;
+        if (++inUse > maxInUse)
+          maxInUse = inUse;
+      }
+
+      POS_SCHED_UNLOCK;
+      return reinterpret_cast<T*>(b);
+    }
+
+/**
+ * Returns a block back to pool.
+ * @param   ptr  block allocated with ::pos::Pool::alloc.
+ * @sa      alloc, destroy
+ */
+    inline void free(T* ptr)
+    {
+      POS_LOCKFLAGS;
+      Block* b = reinterpret_cast<Block*>(ptr);
+
+      POS_SCHED_LOCK;
+      b->next = freeList;
+      freeList = b;
+      --inUse;
+      POS_SCHED_UNLOCK;
+    }
+
+/**
+ * Allocates a block from pool and constructs an object into it
+ * using given constructor arguments.
+ * @return  pointer to new object. NULL is returned if all
+ *          blocks are in use.
+ * @sa      destroy, alloc
+ */
+    template<typename... Args>
+    inline T* construct(Args&&... args)
+    {
+      T* ptr = alloc();
+
+      if (ptr == NULL)
+        return NULL;
+
+      return new (ptr) T(static_cast<Args&&>(args)...);
+    }
+
+/**
+ * Destructs an object and returns its block back to pool.
+ * @param   ptr  object created with ::pos::Pool::construct.
+ * @sa      construct, free
+ */
+    inline void destroy(T* ptr)
+    {
+      ptr->~T();
+      free(ptr);
+    }
+
+/**
+ * Returns number of blocks currently in use.
+ */
+    inline UINT_t used() const
+    {
+      return inUse;
+    }
+
+/**
+ * Returns maximum number of blocks that have been in use
+ * at the same time.
+ */
+    inline UINT_t highWater() const
+    {
+      return maxInUse;
+    }
+
+/**
+ * Returns number of blocks in pool.
+ */
+    static inline UINT_t capacity()
+    {
+      return N;
+    }
+
+  private:
+    union Block {
+      Block* next;
+      alignas(T) unsigned char data[sizeof(T)];
+    };
+
+    Block blocks[N];
+    Block* freeList;
+    UINT_t inUse;
+    UINT_t maxInUse;
+
+    Pool(const Pool&);
+    Pool& operator=(const Pool&);
+  };
+
+/**
+ * Bump allocator for memory that is allocated during system
+ * startup and never freed (task stacks, message buffers,
+ * static tables). Allocation just advances a pointer inside
+ * a memory area given by user, so it is fast and causes no
+ * fragmentation. Allocated memory is released only all at once
+ * by ::pos::Arena::reset.
+ * @sa ::pos::StaticArena
+ */
+  class Arena
+  {
+  public:
+
+/* 
+ * Constructors.
+ */
+    inline Arena(void* mem, UINT_t size)
+    {
+      base = static_cast<unsigned char*>(mem);
+      top = 0;
+      limit = size;
+    }
+
+/**
+ * Allocates memory from arena.
+ * @param   size   number of bytes to allocate.
+ * @param   align  alignment of memory, must be a power of two.
+ * @return  pointer to memory. NULL is returned if arena does not
+ *          have enough space left.
+ * @sa      construct, reset
+ */
+    inline void* alloc(UINT_t size, UINT_t align = alignof(max_align_t))
+    {
+      POS_LOCKFLAGS;
+      void* ptr = NULL;
+      UINT_t pad;
+
+      POS_SCHED_LOCK;
+      pad = (UINT_t)(-(size_t)(base + top) & (align - 1));
+      if (pad <= limit - top && size <= limit - top - pad) {
+
+        ptr = base + top + pad;
+        top += pad + size;
+      }
+
+      POS_SCHED_UNLOCK;
+      return ptr;
+    }
+
+/**
+ * Allocates memory from arena and constructs an object into it
+ * using given constructor arguments.
+ * @return  pointer to new object. NULL is returned if arena does not
+ *          have enough space left.
+ * @sa      alloc
+ */
+    template<class T, typename... Args>
+    inline T* construct(Args&&... args)
+    {
+      void* ptr = alloc(sizeof(T), alignof(T));
+
+      if (ptr == NULL)
+        return NULL;
+
+      return new (ptr) T(static_cast<Args&&>(args)...);
+    }
+
+/**
+ * Releases all memory allocated from arena. Objects
+ * constructed into arena are not destructed.
+ */
+    inline void reset()
+    {
+      top = 0;
+    }
+
+/**
+ * Returns number of bytes allocated from arena.
+ */
+    inline UINT_t used() const
+    {
+      return top;
+    }
+
+/**
+ * Returns number of bytes still available in arena.
+ */
+    inline UINT_t remaining() const
+    {
+      return limit - top;
+    }
+
+  private:
+    unsigned char* base;
+    UINT_t top;
+    UINT_t limit;
+
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+  };
+
+/**
+ * Arena that contains its own memory area of Size bytes.
+ * @code
+ * static pos::StaticArena<4096> startupMem;
+ * @endcode
+ */
+  template<UINT_t Size>
+  class StaticArena : public Arena
+  {
+  public:
+    inline StaticArena() : Arena(mem, Size)
+    {
+    }
+
+  private:
+    alignas(max_align_t) unsigned char mem[Size];
+  };
+}
+
+#endif /* _PICOOS_POOL_HXX */
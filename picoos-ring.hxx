@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-ring.hxx
+ * @brief   Pico]OS oo-wrapper Ring
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_RING_HXX
+#define _PICOOS_RING_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+namespace pos {
+
+/**
+ * Wakeup policy for ::pos::Ring that does not wake anybody up.
+ * Consumer must poll the ring.
+ */
+  class RingNoWakeup
+  {
+  protected:
+    static const bool enabled = false;
+
+    inline void notify(UINT_t, UINT_t)
+    {
+    }
+  };
+
+#if (DOX!=0) || (POSCFG_FEATURE_SEMAPHORES != 0)
+/**
+ * Wakeup policy for ::pos::Ring that signals a semaphore when
+ * the number of elements in ring crosses the high-water mark.
+ * With default high-water mark of 1 the semaphore is signaled
+ * only when ring goes from empty to non-empty.
+ */
+  class RingSemaWakeup
+  {
+  public:
+    inline RingSemaWakeup()
+    {
+      highWater = 1;
+    }
+
+/**
+ * Sets semaphore to signal.
+ * @param   s   semaphore that consumer waits on.
+ * @param   hw  high-water mark. Semaphore is signaled when
+ *              the number of elements reaches this value.
+ * @sa      ::pos::Ring::wait
+ */
+    inline void setWakeup(const Sema& s, UINT_t hw = 1)
+    {
+      sema = s;
+      highWater = hw;
+    }
+
+  protected:
+    static const bool enabled = true;
+
+    inline void notify(UINT_t before, UINT_t after)
+    {
+      if (before < highWater && after >= highWater)
+        sema.signal();
+    }
+
+#if (DOX!=0) || (POSCFG_FEATURE_SEMAWAIT != 0)
+    inline VAR_t waitWakeup(UINT_t timeoutticks)
+    {
+      return sema.wait(timeoutticks);
+    }
+#endif
+
+  private:
+    Sema sema;
+    UINT_t highWater;
+  };
+#endif
+
+#if (DOX!=0) || (POSCFG_FEATURE_FLAGS != 0)
+/**
+ * Wakeup policy for ::pos::Ring that sets a flag when
+ * the number of elements in ring crosses the high-water mark.
+ * Useful when consumer task waits for several event sources
+ * with one flag object.@n
+ * @n
+ * ::pos::Ring::wait can be used when ring is the only source
+ * setting flags. Consumer that waits on the flag object itself
+ * must do a full memory fence (__atomic_thread_fence(__ATOMIC_SEQ_CST))
+ * before checking ::pos::Ring::empty, otherwise it can miss
+ * elements pushed just before it goes to wait.
+ */
+  class RingFlagWakeup
+  {
+  public:
+    inline RingFlagWakeup()
+    {
+      flgnum = 0;
+      highWater = 1;
+    }
+
+/**
+ * Sets flag to signal.
+ * @param   f   flag object that consumer waits on.
+ * @param   n   flag number to set.
+ * @param   hw  high-water mark. Flag is set when
+ *              the number of elements reaches this value.
+ */
+    inline void setWakeup(const Flag& f, UVAR_t n, UINT_t hw = 1)
+    {
+      flag = f;
+      flgnum = n;
+      highWater = hw;
+    }
+
+  protected:
+    static const bool enabled = true;
+
+    inline void notify(UINT_t before, UINT_t after)
+    {
+      if (before < highWater && after >= highWater)
+        flag.set(flgnum);
+    }
+
+#if (DOX!=0) || (POSCFG_FEATURE_FLAGWAIT != 0)
+    inline VAR_t waitWakeup(UINT_t timeoutticks)
+    {
+      VAR_t flags = flag.wait(timeoutticks);
+
+      if (flags < 0)
+        return flags;
+
+      return (flags == 0) ? 1 : 0;
+    }
+#endif
+
+  private:
+    Flag flag;
+    UVAR_t flgnum;
+    UINT_t highWater;
+  };
+#endif
+
+/**
+ * Lock-free single producer, single consumer ring buffer.
+ * Ring is intended for moving data from a software interrupt
+ * handler (see ::pos::SoftInt) to a task without disabling interrupts
+ * and without one kernel call per element. Producer and
+ * consumer may run in any context, as long as there is only
+ * one of each.@n
+ * @n
+ * Optional wakeup policy (::pos::RingSemaWakeup or ::pos::RingFlagWakeup)
+ * wakes the consumer only when the ring becomes non-empty (or
+ * when it fills up to the high-water mark), so a burst of elements
+ * costs only one wakeup. Consumer can process elements directly in
+ * ring memory with ::pos::Ring::peek and ::pos::Ring::consume.
+ * @code
+ * static pos::Ring<char, 64, pos::RingSemaWakeup> rx;
+ *
+ * static void uartHandler(UVAR_t arg)
+ * {
+ *   rx.push(UART_DATA);
+ * }
+ *
+ * static void rxTask(void* arg)
+ * {
+ *   pos::Sema sema;
+ *   char* data;
+ *   UINT_t n;
+ *
+ *   sema.create(0);
+ *   rx.setWakeup(sema);
+ *   for (;;) {
+ *
+ *     rx.wait(INFINITE);
+ *     while ((n = rx.peek(data)) > 0) {
+ *
+ *       process(data, n);
+ *       rx.consume(n);
+ *     }
+ *   }
+ * }
+ * @endcode
+ * @param   T  element type. Elements are copied with assignment.
+ * @param   N  number of elements, must be a power of two.
+ * @param   Wakeup wakeup policy.
+ */
+  template<class T, UINT_t N, class Wakeup = RingNoWakeup>
+  class Ring : public Wakeup
+  {
+  public:
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "Ring size must be power of two");
+
+/* 
+ * Constructors.
+ */
+    inline Ring()
+    {
+      head = 0;
+      tail = 0;
+    }
+
+/**
+ * Adds an element to ring. Called by producer.
+ * @param   value  element to add.
+ * @return  zero on success. -1 is returned when ring is full
+ *          (element is dropped).
+ * @sa      write, pop, peek
+ */
+    inline VAR_t push(const T& value)
+    {
+      UINT_t h = head;
+
+      if (h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) == N)
+        return -1;
+
+      buf[h & (N - 1)] = value;
+      __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE);
+      wakeup(h, 1);
+      return 0;
+    }
+
+/**
+ * Adds several elements to ring. Called by producer.
+ * Consumer is notified only once.
+ * @param   values  elements to add.
+ * @param   n       number of elements.
+ * @return  number of elements added. If ring fills up,
+ *          rest of elements are dropped.
+ * @sa      push, read
+ */
+    UINT_t write(const T* values, UINT_t n)
+    {
+      UINT_t h = head;
+      UINT_t used = h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+
+      if (n > N - used)
+        n = N - used;
+
+      for (UINT_t i = 0; i < n; ++i)
+        buf[(h + i) & (N - 1)] = values[i];
+
+      if (n > 0) {
+
+        __atomic_store_n(&head, h + n, __ATOMIC_RELEASE);
+        wakeup(h, n);
+      }
+
+      return n;
+    }
+
+/**
+ * Removes an element from ring. Called by consumer.
+ * @param   value  removed element is stored here.
+ * @return  zero on success. -1 is returned when ring is empty.
+ * @sa      push, peek, consume
+ */
+    inline VAR_t pop(T& value)
+    {
+      UINT_t t = tail;
+
+      if (__atomic_load_n(&head, __ATOMIC_ACQUIRE) == t)
+        return -1;
+
+      value = buf[t & (N - 1)];
+      __atomic_store_n(&tail, t + 1, __ATOMIC_RELEASE);
+      return 0;
+    }
+
+/**
+ * Returns contiguous block of elements that can be processed in
+ * place. Because of wrap-around, the block may not contain all
+ * available elements, call again after ::pos::Ring::consume to get the rest.
+ * Called by consumer.
+ * @param   span  set to point to first available element.
+ * @return  number of elements in block. Zero when ring is empty.
+ * @sa      consume, pop
+ */
+    inline UINT_t peek(T*& span)
+    {
+      UINT_t t = tail;
+      UINT_t n = __atomic_load_n(&head, __ATOMIC_ACQUIRE) - t;
+      UINT_t contiguous = N - (t & (N - 1));
+
+      span = &buf[t & (N - 1)];
+      return (n < contiguous) ? n : contiguous;
+    }
+
+/**
+ * Removes elements returned by ::pos::Ring::peek from ring.
+ * Called by consumer.
+ * @param   n  number of elements to remove.
+ * @sa      peek
+ */
+    inline void consume(UINT_t n)
+    {
+      __atomic_store_n(&tail, tail + n, __ATOMIC_RELEASE);
+    }
+
+/**
+ * Waits until ring is not empty. Available with
+ * ::pos::RingSemaWakeup and ::pos::RingFlagWakeup policies.
+ * With flag policy all flags set in flag object are cleared.
+ * Called by consumer.
+ * @param   timeoutticks  timeout in timer ticks
+ *          (see ::HZ define and ::MS macro).
+ *          If this parameter is set to INFINITE, the
+ *          function will never time out.
+ * @return  zero when ring has elements. A positive value (1 or TRUE) 
+ *          is returned when the timeout was reached.
+ * @note    ::POSCFG_FEATURE_SEMAWAIT (or ::POSCFG_FEATURE_FLAGWAIT
+ *          with flag policy) must be defined to 1
+ *          to have this function compiled in.
+ * @sa      peek, pop, ::pos::RingSemaWakeup, ::pos::RingFlagWakeup
+ */
+    inline VAR_t wait(UINT_t timeoutticks)
+    {
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+      if (!empty())
+        return 0;
+
+      return this->waitWakeup(timeoutticks);
+    }
+
+/**
+ * Returns number of elements in ring.
+ */
+    inline UINT_t size() const
+    {
+      return __atomic_load_n(&head, __ATOMIC_ACQUIRE) -
+             __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+    }
+
+/**
+ * Returns true if ring is empty.
+ */
+    inline bool empty() const
+    {
+      return size() == 0;
+    }
+
+/**
+ * Returns maximum number of elements in ring.
+ */
+    static inline UINT_t capacity()
+    {
+      return N;
+    }
+
+  private:
+
+/*
+ * Producer has published n elements starting at index h.
+ * Tail is re-read after a full fence, so either the consumer
+ * sees new head before going to sleep or the element count
+ * seen here is up to date (consumer does the same in wait).
+ * If consumer has already taken new elements no wakeup is needed.
+ */
+    inline void wakeup(UINT_t h, UINT_t n)
+    {
+      if (!Wakeup::enabled)
+        return;
+
+      __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+      UINT_t before = h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+
+      if (before <= N)
+        this->notify(before, before + n);
+    }
+
+    T buf[N];
+    UINT_t head;
+    UINT_t tail;
+
+    Ring(const Ring&);
+    Ring& operator=(const Ring&);
+  };
+}
+
+#endif /* _PICOOS_RING_HXX */
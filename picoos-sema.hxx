@@ -225,14 +225,23 @@ namespace nos {
  */
     inline Sema()
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = NULL;
+#endif
     };
 
     inline Sema(const Sema& other) : pos::Sema(other)
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = other.stats;
+#endif
     };
 
     inline Sema(const POSSEMA_t other) : pos::Sema(other)
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = NULL;
+#endif
     };
 
 #if DOX!=0 || NOSCFG_FEATURE_SEMAPHORES != 0
@@ -265,7 +274,13 @@ namespace nos {
                         const char *name)
     {
       handle = nosSemaCreate(initcount, options, name);
-      return (handle == NULL) ? -1 : 0;
+      if (handle == NULL)
+        return -1;
+
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      stats = Instrument::attach(name, "sema");
+#endif
+      return 0;
     };
 
     using pos::Sema::create;
@@ -283,6 +298,10 @@ namespace nos {
  */
     inline void destroy()
     {
+#if OOCFG_FEATURE_INSTRUMENT != 0
+      Instrument::detach(stats);
+      stats = NULL;
+#endif
       nosSemaDestroy(handle);
       handle = (POSSEMA_t)0;
     }
@@ -290,6 +309,76 @@ namespace nos {
 #endif
 #endif /* NOSCFG_FEATURE_SEMAPHORES */
 
+#if DOX!=0 || OOCFG_FEATURE_INSTRUMENT != 0
+/**
+ * Gets the semaphore, see ::pos::Sema::get.
+ * If semaphore is not signaled, acquire is counted as
+ * contended and time spent waiting is recorded.
+ * @note    ::OOCFG_FEATURE_INSTRUMENT must be defined to 1
+ *          to have this function compiled in.
+ */
+    inline VAR_t get()
+    {
+      JIF_t start;
+      UVAR_t blocked = 0;
+      VAR_t status;
+
+      if (stats == NULL)
+        return pos::Sema::get();
+
+      start = jiffies;
+#if POSCFG_FEATURE_SEMAWAIT != 0
+      status = pos::Sema::wait(0);
+      if (status > 0) {
+
+        blocked = 1;
+        status = pos::Sema::get();
+      }
+#else
+      status = pos::Sema::get();
+#endif
+
+      if (status == 0)
+        stats->acquired(start, blocked);
+
+      return status;
+    }
+
+#if DOX!=0 || POSCFG_FEATURE_SEMAWAIT != 0
+/**
+ * Gets the semaphore with timeout, see ::pos::Sema::wait.
+ * Acquires are recorded like in ::nos::Sema::get.
+ * @note    ::OOCFG_FEATURE_INSTRUMENT must be defined to 1
+ *          to have this function compiled in.
+ */
+    inline VAR_t wait(UINT_t timeoutticks)
+    {
+      JIF_t start;
+      UVAR_t blocked = 0;
+      VAR_t status;
+
+      if (stats == NULL)
+        return pos::Sema::wait(timeoutticks);
+
+      start = jiffies;
+      status = pos::Sema::wait(0);
+      if (status > 0 && timeoutticks != 0) {
+
+        blocked = 1;
+        status = pos::Sema::wait(timeoutticks);
+      }
+
+      if (status == 0)
+        stats->acquired(start, blocked);
+
+      return status;
+    }
+#endif
+
+  private:
+    LockStats* stats;
+#endif /* OOCFG_FEATURE_INSTRUMENT */
+
   };
 }
 
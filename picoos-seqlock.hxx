@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-seqlock.hxx
+ * @brief   Pico]OS oo-wrapper SeqLock
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_SEQLOCK_HXX
+#define _PICOOS_SEQLOCK_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+#include <string.h>
+
+namespace pos {
+
+/**
+ * Sequence lock for read-mostly shared data, like configuration
+ * or telemetry snapshots. Readers never block each other or writers:
+ * a reader copies the data and retries if a writer changed it
+ * meanwhile, detected by a sequence counter that is odd while
+ * a write is in progress. Compared to protecting the data with
+ * ::pos::Mutex, readers never serialize on a lock and need no
+ * kernel calls.@n
+ * @n
+ * Writer keeps task switching inhibited (or scheduler locked, if
+ * ::POSCFG_FEATURE_INHIBITSCHED is not available) while copying
+ * new data in, so writes from several tasks are serialized and
+ * a reader task cannot interrupt a half-done write. Data should
+ * therefore be a plain structure that is quick to copy.
+ * @code
+ * struct Config { INT_t gain; INT_t offset; UINT_t limits[8]; };
+ * static pos::SeqLock<Config> config;
+ *
+ * Config c;
+ * config.read(c);         // readers
+ * config.write(newConfig); // writer
+ * @endcode
+ * @note    Writing is not allowed from software interrupt handlers.
+ *          Handlers should use tryRead, because a handler may
+ *          interrupt a write in progress.
+ */
+  template<typename T>
+  class SeqLock
+  {
+  public:
+
+/* 
+ * Constructors.
+ */
+    inline SeqLock() : seq(0), data()
+    {
+    }
+
+    inline SeqLock(const T& value) : seq(0), data(value)
+    {
+    }
+
+/**
+ * Reads a consistent copy of data. Retries while data
+ * is changed during copying.
+ * @param   value  destination for copy.
+ * @sa      tryRead, write
+ */
+    inline void read(T& value) const
+    {
+      while (!tryRead(value))
+        ;
+    }
+
+/**
+ * Returns a consistent copy of data.
+ * @sa      read
+ */
+    inline T read() const
+    {
+      T value;
+
+      read(value);
+      return value;
+    }
+
+/**
+ * Tries to read a consistent copy of data once.
+ * @param   value  destination for copy.
+ * @return  true if copy is consistent, false if
+ *          data was being written.
+ * @sa      read
+ */
+    inline bool tryRead(T& value) const
+    {
+      UINT_t s1 = __atomic_load_n(&seq, __ATOMIC_ACQUIRE);
+
+      if (s1 & 1)
+        return false;
+
+      memcpy(&value, (const void*)&data, sizeof(T));
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+      return __atomic_load_n(&seq, __ATOMIC_RELAXED) == s1;
+    }
+
+/**
+ * Replaces data.
+ * @param   value  new data.
+ * @sa      read
+ */
+    inline void write(const T& value)
+    {
+#if POSCFG_FEATURE_INHIBITSCHED != 0
+      ::posTaskSchedLock();
+#else
+      POS_LOCKFLAGS;
+
+      POS_SCHED_LOCK;
+#endif
+
+      UINT_t s = seq;
+
+      __atomic_store_n(&seq, s + 1, __ATOMIC_RELAXED);
+      __atomic_thread_fence(__ATOMIC_RELEASE);
+      memcpy((void*)&data, &value, sizeof(T));
+      __atomic_store_n(&seq, s + 2, __ATOMIC_RELEASE);
+
+#if POSCFG_FEATURE_INHIBITSCHED != 0
+      ::posTaskSchedUnlock();
+#else
+      POS_SCHED_UNLOCK;
+#endif
+    }
+
+/**
+ * Returns sequence number, which is incremented by two
+ * for every write.
+ */
+    inline UINT_t sequence() const
+    {
+      return __atomic_load_n(&seq, __ATOMIC_ACQUIRE);
+    }
+
+  private:
+    UINT_t seq;
+    T data;
+
+    SeqLock(const SeqLock&);
+    SeqLock& operator=(const SeqLock&);
+  };
+}
+
+#endif /* _PICOOS_SEQLOCK_HXX */
@@ -133,6 +133,36 @@ namespace pos {
       return (handle == NULL) ? -1 : 0;
     };
 
+/**
+ * Creates a new task, taking stack memory from an arena instead
+ * of a statically declared array.
+ * @param   funcptr     pointer to the function that shall be executed
+ *                      by the new task.
+ * @param   funcarg     optional argument passed to function.
+ * @param   priority    task priority. Must be in the range
+ *                      0.. ::POSCFG_MAX_PRIO_LEVEL - 1.
+ * @param   stacks      arena to allocate stack memory from.
+ * @param   stacksize   size of the stack memory.
+ * @return  task creation status. -1 is returned when the
+ *          task could not be created or the arena is exhausted.
+ * @note    ::POSCFG_TASKSTACKTYPE <b>must be defined to 0</b>
+ *          to have this function compiled in.@n
+ *          Stack is assumed to grow downwards, so the end of
+ *          allocated memory block is passed to ::posTaskCreate
+ *          as stack start.
+ * @sa      ::posTaskCreate, ::pos::Arena
+ */
+    inline VAR_t create(POSTASKFUNC_t funcptr, void *funcarg,
+                        VAR_t priority, Arena& stacks, UINT_t stacksize)
+    {
+      unsigned char* stack = (unsigned char*)stacks.alloc(stacksize);
+
+      if (stack == NULL)
+        return -1;
+
+      return create(funcptr, funcarg, priority, stack + stacksize);
+    };
+
 #ifndef POSNANO
 /**
  * Operating System Initialization.
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-timerwheel.hxx
+ * @brief   Pico]OS oo-wrapper TimerWheel
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_TIMERWHEEL_HXX
+#define _PICOOS_TIMERWHEEL_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+/**
+ * Number of slots in fine wheel level of ::pos::TimerWheel,
+ * as a power of two. Timeouts shorter than 2^bits wheel ticks
+ * are kept in fine level.
+ */
+#ifndef OOCFG_TIMERWHEEL_FINE_BITS
+#define OOCFG_TIMERWHEEL_FINE_BITS 8
+#endif
+
+/**
+ * Number of slots in coarse wheel level of ::pos::TimerWheel,
+ * as a power of two. Each coarse slot covers whole fine level.
+ * Longer timeouts than both levels together cover are handled
+ * by cascading entries through coarse level several times.
+ */
+#ifndef OOCFG_TIMERWHEEL_COARSE_BITS
+#define OOCFG_TIMERWHEEL_COARSE_BITS 6
+#endif
+
+#if DOX!=0 || (POSCFG_FEATURE_TIMER != 0 && POSCFG_FEATURE_SEMAPHORES != 0 && POSCFG_FEATURE_JIFFIES != 0)
+
+namespace pos {
+
+/**
+ * Timer wheel multiplexes a large number of software timers on
+ * a single ::pos::Timer. Each kernel timer can only signal a semaphore,
+ * so using a kernel timer for every protocol timeout would need
+ * a lot of kernel objects and usually a task per timeout.
+ * Timer wheel instead keeps timers (::pos::TimerWheel::Entry) in
+ * intrusive lists, so arming, cancelling and re-arming a timer
+ * takes constant time and needs no memory allocation.@n
+ * @n
+ * Wheel has two levels: fine level has one slot per wheel tick,
+ * coarse level one slot per full rotation of fine level. Expired
+ * timers are processed in batch by a task calling
+ * ::pos::TimerWheel::process (or ::pos::TimerWheel::run),
+ * and their callbacks are called in the context of that task.
+ * Timers can be armed and cancelled from any task and
+ * from software interrupt handlers.
+ * @code
+ * static pos::TimerWheel wheel;
+ * static pos::TimerWheel::Entry retransmit;
+ *
+ * static void onRetransmit(void* arg)
+ * {
+ *   Session* s = (Session*)arg;
+ *   ...
+ *   wheel.arm(retransmit, MS(200));
+ * }
+ *
+ * wheel.create(1);
+ * retransmit.set(onRetransmit, session);
+ * wheel.arm(retransmit, MS(200));
+ * timerTask.create(pos::TimerWheel::task, &wheel, 3, 1024);
+ * @endcode
+ */
+  class TimerWheel
+  {
+  private:
+    struct Link
+    {
+      Link* next;
+      Link* prev;
+    };
+
+  public:
+
+/**
+ * Callback function called when timer expires.
+ */
+    typedef void (*Callback)(void* arg);
+
+/**
+ * Timer entry. Entries are linked into wheel directly,
+ * so entry must stay valid as long as it is armed.
+ */
+    class Entry : private Link
+    {
+    public:
+      inline Entry()
+      {
+        next = NULL;
+        func = NULL;
+        arg = NULL;
+      }
+
+      inline Entry(Callback f, void* a)
+      {
+        next = NULL;
+        func = f;
+        arg = a;
+      }
+
+/**
+ * Sets function to call when timer expires.
+ * @param   f  callback function.
+ * @param   a  argument for callback function.
+ */
+      inline void set(Callback f, void* a)
+      {
+        func = f;
+        arg = a;
+      }
+
+/**
+ * Returns true if timer is armed.
+ */
+      inline bool armed() const
+      {
+        return next != NULL;
+      }
+
+    private:
+      friend class TimerWheel;
+
+      UINT_t expires;
+      Callback func;
+      void* arg;
+    };
+
+/* 
+ * Constructors.
+ */
+    TimerWheel();
+
+/**
+ * Creates kernel timer and semaphore that drive the wheel
+ * and starts the timer.
+ * @param   resolution  length of wheel tick in timer ticks
+ *                      (see ::HZ define and ::MS macro).
+ * @return  zero on success. -1 is returned when kernel
+ *          objects could not be created.
+ * @sa      destroy, process
+ */
+    VAR_t create(UINT_t resolution);
+
+#if (DOX!=0) || (POSCFG_FEATURE_TIMERDESTROY != 0 && POSCFG_FEATURE_SEMADESTROY != 0)
+/**
+ * Stops the wheel and frees kernel objects. Armed timers
+ * are left as they are.
+ * @note    ::POSCFG_FEATURE_TIMERDESTROY and ::POSCFG_FEATURE_SEMADESTROY
+ *          must be defined to 1 to have this function compiled in.
+ */
+    void destroy();
+#endif
+
+/**
+ * Arms a timer. If timer is already armed, it is re-armed
+ * with new timeout.
+ * @param   entry  timer to arm.
+ * @param   ticks  timeout in timer ticks. Timer expires after at least
+ *                 this many ticks, rounded up to wheel resolution.
+ * @sa      cancel
+ */
+    void arm(Entry& entry, UINT_t ticks);
+
+/**
+ * Cancels a timer. Nothing happens if timer is not armed.
+ * @param   entry  timer to cancel.
+ * @sa      arm
+ */
+    void cancel(Entry& entry);
+
+/**
+ * Waits for next wheel tick and calls callbacks of all timers
+ * that have expired. If processing has fallen behind,
+ * all missed wheel ticks are processed at once.
+ * @return  number of expired timers.
+ * @sa      run, task
+ */
+    UINT_t process();
+
+/**
+ * Processes timers forever.
+ * @sa      process
+ */
+    void run();
+
+/**
+ * Task function that processes timers of wheel given as argument.
+ * Can be passed directly to ::pos::Task::create.
+ */
+    static void task(void* wheel);
+
+/**
+ * Returns number of armed timers.
+ */
+    inline UINT_t count() const
+    {
+      return armedCount;
+    }
+
+  private:
+    enum {
+      FINE   = 1 << OOCFG_TIMERWHEEL_FINE_BITS,
+      COARSE = 1 << OOCFG_TIMERWHEEL_COARSE_BITS
+    };
+
+    void insert(Entry* entry);
+    void advance(Link* expired);
+
+    static inline void unlink(Link* l)
+    {
+      l->prev->next = l->next;
+      l->next->prev = l->prev;
+      l->next = NULL;
+    }
+
+    static inline void append(Link* head, Link* l)
+    {
+      l->prev = head->prev;
+      l->next = head;
+      head->prev->next = l;
+      head->prev = l;
+    }
+
+    static void splice(Link* from, Link* to);
+
+    Link fine[FINE];
+    Link coarse[COARSE];
+    UINT_t now;
+    UINT_t clock;
+    UINT_t armedCount;
+    JIF_t lastJiffies;
+    UINT_t resolution;
+    Timer timer;
+    Sema tick;
+
+    TimerWheel(const TimerWheel&);
+    TimerWheel& operator=(const TimerWheel&);
+  };
+}
+
+#endif /* POSCFG_FEATURE_TIMER */
+#endif /* _PICOOS_TIMERWHEEL_HXX */
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file    picoos-workqueue.hxx
+ * @brief   Pico]OS oo-wrapper WorkQueue
+ * @author  Ari Suutari <ari@stonepile.fi>
+ */
+
+#ifndef _PICOOS_WORKQUEUE_HXX
+#define _PICOOS_WORKQUEUE_HXX
+
+extern "C" {
+
+#include <picoos.h>
+
+}
+
+/**
+ * Number of priority bands in ::pos::WorkQueue. Items in higher
+ * bands are always run before items in lower bands.
+ * Can be defined in noscfg.h.
+ */
+#ifndef OOCFG_WORKQUEUE_BANDS
+#define OOCFG_WORKQUEUE_BANDS 3
+#endif
+
+/**
+ * Maximum number of work items a ::pos::WorkQueue worker
+ * takes from queue at once.
+ */
+#ifndef OOCFG_WORKQUEUE_BATCH
+#define OOCFG_WORKQUEUE_BATCH 8
+#endif
+
+#if DOX!=0 || POSCFG_FEATURE_SEMAPHORES != 0
+
+namespace pos {
+
+/**
+ * Work queue runs short jobs (::pos::WorkQueue::Item) in a small pool
+ * of worker tasks, instead of having a mostly idle task with its own
+ * stack for every kind of asynchronous job. Items are linked into
+ * queue directly, so submitting needs no memory allocation and can
+ * be done from tasks and from software interrupt handlers.
+ * Submitting an item that is already pending does nothing, so
+ * repeated requests for same job are coalesced into one run.
+ * An item never runs in two workers at the same time: if it is
+ * submitted while running, it is queued again once the current
+ * run returns.@n
+ * @n
+ * Each item belongs to a priority band (0 is lowest). A worker
+ * takes up to ::OOCFG_WORKQUEUE_BATCH items from highest non-empty
+ * bands at once and runs them one after another, so a burst of
+ * submits causes only one wakeup. Idle workers are woken up only
+ * when there is work for them.
+ * @code
+ * static pos::WorkQueue wq;
+ * static pos::WorkQueue::Item rxWork(handleRx, &port, 2);
+ *
+ * static void rxInterrupt(UVAR_t arg)
+ * {
+ *   wq.submit(rxWork);
+ * }
+ *
+ * wq.create();
+ * wq.start(2, 3, 1024);
+ * @endcode
+ */
+  class WorkQueue
+  {
+  private:
+    struct Link
+    {
+      Link* next;
+      Link* prev;
+    };
+
+  public:
+
+/**
+ * Function called to run a work item.
+ */
+    typedef void (*Callback)(void* arg);
+
+/**
+ * Work item. Item is linked into queue directly, so it
+ * must stay valid as long as it is pending or running.
+ * Callback does not need to be re-entrant, submitting
+ * the item during its run makes it pending again
+ * but it is run next time only after the current run returns.
+ */
+    class Item : private Link
+    {
+    public:
+      inline Item()
+      {
+        next = NULL;
+        func = NULL;
+        arg = NULL;
+        band = 0;
+        running = false;
+        again = false;
+      }
+
+      inline Item(Callback f, void* a, UVAR_t b = 0)
+      {
+        next = NULL;
+        func = f;
+        arg = a;
+        band = b;
+        running = false;
+        again = false;
+      }
+
+/**
+ * Sets function to call and priority band of item.
+ * Item must not be pending or running.
+ * @param   f  function to call.
+ * @param   a  argument for function.
+ * @param   b  priority band, 0 is lowest.
+ */
+      inline void set(Callback f, void* a, UVAR_t b = 0)
+      {
+        func = f;
+        arg = a;
+        band = b;
+      }
+
+/**
+ * Returns true if item is waiting in queue, or has been
+ * submitted again while running.
+ */
+      inline bool pending() const
+      {
+        return next != NULL || again;
+      }
+
+    private:
+      friend class WorkQueue;
+
+      Callback func;
+      void* arg;
+      UVAR_t band;
+      bool running;
+      bool again;
+#if POSCFG_FEATURE_JIFFIES != 0
+      JIF_t queued;
+#endif
+    };
+
+/**
+ * Work queue counters.
+ */
+    struct Stats
+    {
+      UINT_t submitted;   //!< number of items queued
+      UINT_t coalesced;   //!< number of submits ignored because item was pending
+      UINT_t executed;    //!< number of items run
+      UINT_t wakeups;     //!< number of times a worker was woken up
+      UINT_t maxDepth;    //!< maximum number of pending items
+      JIF_t maxLatency;   //!< maximum time in ticks from submit to start of run
+      JIF_t totalLatency; //!< sum of latencies, divide by executed to get average
+    };
+
+/* 
+ * Constructors.
+ */
+    WorkQueue();
+
+/**
+ * Creates semaphore used to wake up workers.
+ * @return  zero on success, -1 on failure.
+ * @sa      start, worker
+ */
+    VAR_t create();
+
+#if DOX!=0 || (POSCFG_ENABLE_NANO != 0 && NOSCFG_FEATURE_TASKCREATE != 0)
+/**
+ * Starts worker tasks.
+ * @param   workers    number of worker tasks.
+ * @param   priority   priority of worker tasks.
+ * @param   stacksize  stack size of each worker task.
+ * @return  zero on success, -1 if some worker could not be created.
+ * @note    ::NOSCFG_FEATURE_TASKCREATE must be defined to 1
+ *          to have this function compiled in. Otherwise,
+ *          workers can be created with ::pos::Task::create
+ *          using ::pos::WorkQueue::worker as task function.
+ */
+    VAR_t start(UINT_t workers, VAR_t priority, UINT_t stacksize);
+#endif
+
+/**
+ * Submits item to queue. If item is already pending, nothing is done.
+ * Can be called from tasks and software interrupt handlers.
+ * @param   item  item to run.
+ * @return  true if item was queued, false if it was already pending.
+ * @sa      cancel
+ */
+    bool submit(Item& item);
+
+/**
+ * Removes pending item from queue.
+ * @param   item  item to remove.
+ * @return  true if item was pending.
+ * @sa      submit
+ */
+    bool cancel(Item& item);
+
+/**
+ * Runs pending items in calling task, without waiting.
+ * @return  number of items run.
+ */
+    UINT_t process();
+
+/**
+ * Worker task function, argument must point to ::pos::WorkQueue.
+ */
+    static void worker(void* queue);
+
+/**
+ * Returns number of pending items in a band.
+ * @param   band  priority band.
+ */
+    inline UINT_t depth(UVAR_t band) const
+    {
+      return depths[(band < OOCFG_WORKQUEUE_BANDS) ? band : OOCFG_WORKQUEUE_BANDS - 1];
+    }
+
+/**
+ * Returns copy of counters.
+ * @sa      resetStats
+ */
+    Stats stats() const;
+
+/**
+ * Clears counters.
+ * @sa      stats
+ */
+    void resetStats();
+
+  private:
+    bool enqueue(Item& item);
+    void started(Item* item);
+    bool finished(Item* item);
+    UINT_t take(Item** batch);
+    void execute(Item** batch, UINT_t count);
+
+    Link queues[OOCFG_WORKQUEUE_BANDS];
+    UINT_t depths[OOCFG_WORKQUEUE_BANDS];
+    UINT_t total;
+    UINT_t idle;
+    UINT_t signaled;
+    Stats counters;
+    Sema ready;
+
+    WorkQueue(const WorkQueue&);
+    WorkQueue& operator=(const WorkQueue&);
+  };
+}
+
+#endif /* POSCFG_FEATURE_SEMAPHORES */
+#endif /* _PICOOS_WORKQUEUE_HXX */
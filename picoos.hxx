@@ -78,6 +78,8 @@ namespace pos {
 namespace nos {
 }
 
+#include <picoos-instrument.hxx>
+#include <picoos-pool.hxx>
 #include <picoos-task.hxx>
 
 #include <picoos-atomic.hxx>
@@ -88,9 +90,17 @@ namespace nos {
 #include <picoos-softint.hxx>
 #include <picoos-timer.hxx>
 
+#include <picoos-channel.hxx>
+#include <picoos-ring.hxx>
+#include <picoos-seqlock.hxx>
+#include <picoos-timerwheel.hxx>
+#include <picoos-workqueue.hxx>
+#include <picoos-coroutine.hxx>
+
 #if POSCFG_ENABLE_NANO != 0
 
 #include <picoos-console.hxx>
+#include <picoos-log.hxx>
 
 #endif
 
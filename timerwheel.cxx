@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <picoos.hxx>
+
+#if POSCFG_FEATURE_TIMER != 0 && POSCFG_FEATURE_SEMAPHORES != 0 && POSCFG_FEATURE_JIFFIES != 0
+
+namespace pos {
+
+/*
+ * Wheel time is counted in wheel ticks. Variable now is the last
+ * wheel tick that has been processed and clock is the wheel tick
+ * that corresponds to lastJiffies. They differ while process() is
+ * catching up. Timers are armed relative to clock and placed into
+ * slots relative to now.
+ */
+
+  TimerWheel::TimerWheel()
+  {
+    for (UINT_t i = 0; i < FINE; ++i)
+      fine[i].next = fine[i].prev = &fine[i];
+
+    for (UINT_t i = 0; i < COARSE; ++i)
+      coarse[i].next = coarse[i].prev = &coarse[i];
+
+    now = 0;
+    clock = 0;
+    armedCount = 0;
+    lastJiffies = 0;
+    resolution = 1;
+  }
+
+  VAR_t TimerWheel::create(UINT_t res)
+  {
+    resolution = (res > 0) ? res : 1;
+    lastJiffies = jiffies;
+
+    if (tick.create(0) != 0)
+      return -1;
+
+    if (timer.create() == 0) {
+
+      if (timer.set(tick, resolution, resolution) == 0 && timer.start() == 0)
+        return 0;
+
+/*
+ * Release what was created before the failure.
+ */
+#if POSCFG_FEATURE_TIMERDESTROY != 0
+      timer.destroy();
+#endif
+    }
+
+#if POSCFG_FEATURE_SEMADESTROY != 0
+    tick.destroy();
+#endif
+
+    return -1;
+  }
+
+#if POSCFG_FEATURE_TIMERDESTROY != 0 && POSCFG_FEATURE_SEMADESTROY != 0
+
+  void TimerWheel::destroy()
+  {
+    timer.stop();
+    timer.destroy();
+    tick.destroy();
+  }
+
+#endif
+
+/*
+ * Move all entries from one list to end of another.
+ */
+  void TimerWheel::splice(Link* from, Link* to)
+  {
+    Link* first = from->next;
+    Link* last = from->prev;
+
+    if (first == from)
+      return;
+
+    first->prev = to->prev;
+    to->prev->next = first;
+    last->next = to;
+    to->prev = last;
+
+    from->next = from->prev = from;
+  }
+
+/*
+ * Put entry into slot. Must be called with scheduler locked.
+ */
+  void TimerWheel::insert(Entry* entry)
+  {
+    UINT_t delta = entry->expires - now;
+    Link* head;
+
+    if (delta < FINE)
+      head = &fine[entry->expires & (FINE - 1)];
+    else if (delta < (UINT_t)FINE * COARSE)
+      head = &coarse[(entry->expires >> OOCFG_TIMERWHEEL_FINE_BITS) & (COARSE - 1)];
+    else
+      head = &coarse[(now >> OOCFG_TIMERWHEEL_FINE_BITS) & (COARSE - 1)];
+
+    append(head, entry);
+  }
+
+  void TimerWheel::arm(Entry& entry, UINT_t ticks)
+  {
+    POS_LOCKFLAGS;
+    UINT_t units;
+
+    POS_SCHED_LOCK;
+    if (entry.next != NULL)
+      unlink(&entry);
+    else
+      ++armedCount;
+
+    units = ((UINT_t)(jiffies - lastJiffies) + ticks + resolution - 1) / resolution;
+    if (units == 0)
+      units = 1;
+
+    entry.expires = clock + units;
+    insert(&entry);
+    POS_SCHED_UNLOCK;
+  }
+
+  void TimerWheel::cancel(Entry& entry)
+  {
+    POS_LOCKFLAGS;
+
+    POS_SCHED_LOCK;
+    if (entry.next != NULL) {
+
+      unlink(&entry);
+      --armedCount;
+    }
+
+    POS_SCHED_UNLOCK;
+  }
+
+/*
+ * Process one wheel tick. When fine level wraps around,
+ * entries from next coarse slot are redistributed first.
+ * Lists are manipulated one entry at a time, so scheduler
+ * is locked only for short periods. Entries in temporary
+ * lists are still armed and can be cancelled normally.
+ */
+  void TimerWheel::advance(Link* expired)
+  {
+    POS_LOCKFLAGS;
+    Link pending;
+    UINT_t next = now + 1;
+
+    pending.next = pending.prev = &pending;
+
+    POS_SCHED_LOCK;
+    if ((next & (FINE - 1)) == 0)
+      splice(&coarse[(next >> OOCFG_TIMERWHEEL_FINE_BITS) & (COARSE - 1)], &pending);
+
+    now = next;
+    POS_SCHED_UNLOCK;
+
+    for (;;) {
+
+      POS_SCHED_LOCK;
+      if (pending.next == &pending) {
+
+        POS_SCHED_UNLOCK;
+        break;
+      }
+
+      Entry* entry = static_cast<Entry*>(pending.next);
+
+      unlink(entry);
+      insert(entry);
+      POS_SCHED_UNLOCK;
+    }
+
+    POS_SCHED_LOCK;
+    splice(&fine[now & (FINE - 1)], expired);
+    POS_SCHED_UNLOCK;
+  }
+
+  UINT_t TimerWheel::process()
+  {
+    POS_LOCKFLAGS;
+    Link expired;
+    UINT_t elapsed;
+    UINT_t count = 0;
+
+    expired.next = expired.prev = &expired;
+    tick.get();
+
+    POS_SCHED_LOCK;
+    elapsed = (UINT_t)(jiffies - lastJiffies) / resolution;
+    lastJiffies += elapsed * resolution;
+    clock += elapsed;
+    if (armedCount == 0)
+      now = clock;
+
+    POS_SCHED_UNLOCK;
+
+    while (now != clock)
+      advance(&expired);
+
+    for (;;) {
+
+      Callback func;
+      void* arg;
+
+      POS_SCHED_LOCK;
+      if (expired.next == &expired) {
+
+        POS_SCHED_UNLOCK;
+        break;
+      }
+
+      Entry* entry = static_cast<Entry*>(expired.next);
+
+      unlink(entry);
+      --armedCount;
+      func = entry->func;
+      arg = entry->arg;
+      POS_SCHED_UNLOCK;
+
+      if (func != NULL)
+        func(arg);
+
+      ++count;
+    }
+
+    return count;
+  }
+
+  void TimerWheel::run()
+  {
+    for (;;)
+      process();
+  }
+
+  void TimerWheel::task(void* wheel)
+  {
+    static_cast<TimerWheel*>(wheel)->run();
+  }
+}
+
+#endif
@@ -0,0 +1,345 @@
+/*
+ * Copyright (c) 2026, Ari Suutari <ari@stonepile.fi>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. The name of the author may not be used to endorse or promote
+ *     products derived from this software without specific prior written
+ *     permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS
+ * OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT,
+ * INDIRECT,  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <picoos.hxx>
+
+#if POSCFG_FEATURE_SEMAPHORES != 0
+
+namespace pos {
+
+  WorkQueue::WorkQueue()
+  {
+    for (UVAR_t b = 0; b < OOCFG_WORKQUEUE_BANDS; ++b) {
+
+      queues[b].next = queues[b].prev = &queues[b];
+      depths[b] = 0;
+    }
+
+    total = 0;
+    idle = 0;
+    signaled = 0;
+    resetStats();
+  }
+
+  VAR_t WorkQueue::create()
+  {
+    return ready.create(0);
+  }
+
+#if POSCFG_ENABLE_NANO != 0 && NOSCFG_FEATURE_TASKCREATE != 0
+
+  VAR_t WorkQueue::start(UINT_t workers, VAR_t priority, UINT_t stacksize)
+  {
+    for (UINT_t i = 0; i < workers; ++i) {
+
+      nos::Task task;
+
+      if (task.create(worker, this, priority, stacksize, "work") != 0)
+        return -1;
+    }
+
+    return 0;
+  }
+
+#endif
+
+/*
+ * Link item to tail of its band. Workers are woken up only if
+ * there are idle workers that have not been signaled yet.
+ * This keeps semaphore count in line with number of idle workers,
+ * so a burst of submits does not cause extra wakeups.
+ * Must be called with scheduler locked, returns true if
+ * a worker should be woken up.
+ */
+  bool WorkQueue::enqueue(Item& item)
+  {
+    Link* head;
+    UVAR_t b = (item.band < OOCFG_WORKQUEUE_BANDS) ? item.band : OOCFG_WORKQUEUE_BANDS - 1;
+
+    head = &queues[b];
+    item.prev = head->prev;
+    item.next = head;
+    head->prev->next = &item;
+    head->prev = &item;
+
+    ++depths[b];
+    ++total;
+    if (total > counters.maxDepth)
+      counters.maxDepth = total;
+
+    if (idle > signaled) {
+
+      ++signaled;
+      return true;
+    }
+
+    return false;
+  }
+
+/*
+ * Item that is running is not linked into queue when
+ * submitted. It is marked to be queued again when
+ * current run returns, so that no other worker
+ * can run it at the same time.
+ */
+  bool WorkQueue::submit(Item& item)
+  {
+    POS_LOCKFLAGS;
+    bool wake = false;
+
+    POS_SCHED_LOCK;
+    if (item.next != NULL || item.again) {
+
+      ++counters.coalesced;
+      POS_SCHED_UNLOCK;
+      return false;
+    }
+
+#if POSCFG_FEATURE_JIFFIES != 0
+    item.queued = jiffies;
+#endif
+
+    ++counters.submitted;
+    if (item.running)
+      item.again = true;
+    else
+      wake = enqueue(item);
+
+    POS_SCHED_UNLOCK;
+
+    if (wake)
+      ready.signal();
+
+    return true;
+  }
+
+  bool WorkQueue::cancel(Item& item)
+  {
+    POS_LOCKFLAGS;
+    bool found = false;
+
+    POS_SCHED_LOCK;
+    if (item.next != NULL) {
+
+      item.prev->next = item.next;
+      item.next->prev = item.prev;
+      item.next = NULL;
+      --depths[(item.band < OOCFG_WORKQUEUE_BANDS) ? item.band : OOCFG_WORKQUEUE_BANDS - 1];
+      --total;
+      found = true;
+    }
+    else if (item.again) {
+
+      item.again = false;
+      found = true;
+    }
+
+    POS_SCHED_UNLOCK;
+    return found;
+  }
+
+/*
+ * Take a batch of items, highest band first. Must
+ * be called with scheduler locked.
+ */
+  UINT_t WorkQueue::take(Item** batch)
+  {
+    UINT_t n = 0;
+    VAR_t b = OOCFG_WORKQUEUE_BANDS - 1;
+
+    while (b >= 0 && n < OOCFG_WORKQUEUE_BATCH) {
+
+      Link* head = &queues[b];
+
+      if (head->next == head) {
+
+        --b;
+        continue;
+      }
+
+      Item* item = static_cast<Item*>(head->next);
+
+      head->next = item->next;
+      item->next->prev = head;
+      item->next = NULL;
+      item->running = true;
+      --depths[b];
+      --total;
+
+      batch[n++] = item;
+    }
+
+    return n;
+  }
+
+/*
+ * Update counters when item starts to run. Must
+ * be called with scheduler locked.
+ */
+  void WorkQueue::started(Item* item)
+  {
+    ++counters.executed;
+
+#if POSCFG_FEATURE_JIFFIES != 0
+    JIF_t latency = jiffies - item->queued;
+
+    counters.totalLatency += latency;
+    if (latency > counters.maxLatency)
+      counters.maxLatency = latency;
+#endif
+  }
+
+/*
+ * Clear running state of item and queue it again if it was
+ * submitted during the run. Must be called with scheduler locked,
+ * returns true if a worker should be woken up.
+ */
+  bool WorkQueue::finished(Item* item)
+  {
+    item->running = false;
+    if (!item->again)
+      return false;
+
+    item->again = false;
+    return enqueue(*item);
+  }
+
+/*
+ * Scheduler lock taken after each run is also used to
+ * update counters of the next item in batch.
+ */
+  void WorkQueue::execute(Item** batch, UINT_t count)
+  {
+    POS_LOCKFLAGS;
+    bool wake;
+
+    POS_SCHED_LOCK;
+    started(batch[0]);
+    POS_SCHED_UNLOCK;
+
+    for (UINT_t i = 0; i < count; ++i) {
+
+      batch[i]->func(batch[i]->arg);
+
+      POS_SCHED_LOCK;
+      wake = finished(batch[i]);
+      if (i + 1 < count)
+        started(batch[i + 1]);
+
+      POS_SCHED_UNLOCK;
+
+      if (wake)
+        ready.signal();
+    }
+  }
+
+  UINT_t WorkQueue::process()
+  {
+    POS_LOCKFLAGS;
+    Item* batch[OOCFG_WORKQUEUE_BATCH];
+    UINT_t count = 0;
+    UINT_t n;
+
+    for (;;) {
+
+      POS_SCHED_LOCK;
+      n = take(batch);
+      POS_SCHED_UNLOCK;
+
+      if (n == 0)
+        break;
+
+      execute(batch, n);
+      count += n;
+    }
+
+    return count;
+  }
+
+  void WorkQueue::worker(void* arg)
+  {
+    POS_LOCKFLAGS;
+    WorkQueue* q = static_cast<WorkQueue*>(arg);
+    Item* batch[OOCFG_WORKQUEUE_BATCH];
+    UINT_t n;
+
+    for (;;) {
+
+      POS_SCHED_LOCK;
+      n = q->take(batch);
+      if (n == 0)
+        ++q->idle;
+
+      POS_SCHED_UNLOCK;
+
+      if (n == 0) {
+
+        q->ready.get();
+
+        POS_SCHED_LOCK;
+        --q->idle;
+        --q->signaled;
+        ++q->counters.wakeups;
+        POS_SCHED_UNLOCK;
+        continue;
+      }
+
+      q->execute(batch, n);
+    }
+  }
+
+  WorkQueue::Stats WorkQueue::stats() const
+  {
+    POS_LOCKFLAGS;
+    Stats s;
+
+    POS_SCHED_LOCK;
+    s = counters;
+    POS_SCHED_UNLOCK;
+    return s;
+  }
+
+  void WorkQueue::resetStats()
+  {
+    POS_LOCKFLAGS;
+
+    POS_SCHED_LOCK;
+    counters.submitted = 0;
+    counters.coalesced = 0;
+    counters.executed = 0;
+    counters.wakeups = 0;
+    counters.maxDepth = total;
+    counters.maxLatency = 0;
+    counters.totalLatency = 0;
+    POS_SCHED_UNLOCK;
+  }
+}
+
+#endif